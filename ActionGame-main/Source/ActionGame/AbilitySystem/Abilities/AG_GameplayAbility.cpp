@@ -6,20 +6,133 @@
 #include "AbilitySystemComponent.h"
 #include "ActionGameCharacter.h"
 #include "AbilitySystemLog.h"
+#include "ActionGameStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Effect Specs Created"), STAT_AbilityEffectSpecsCreated, STATGROUP_ActionGame);
+
+#if !UE_BUILD_SHIPPING
+namespace AbilityEffectSpecStats
+{
+	static TMap<FName, int32> SpecsCreatedPerClass;
+	static double LastResetTime = 0.0;
+}
+
+static FAutoConsoleCommand CmdAbilityEffectSpecStats(
+	TEXT("AbilityEffectSpecStats"),
+	TEXT("Logs outgoing effect specs created per ability class since the last call, then resets the counts"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const double Now = FPlatformTime::Seconds();
+		const double Elapsed = AbilityEffectSpecStats::LastResetTime > 0.0 ? Now - AbilityEffectSpecStats::LastResetTime : 0.0;
+
+		for (const TPair<FName, int32>& Entry : AbilityEffectSpecStats::SpecsCreatedPerClass)
+		{
+			ABILITY_LOG(Display, TEXT("%s: %d specs created (%.2f/s)"), *Entry.Key.ToString(), Entry.Value, Elapsed > 0.0 ? Entry.Value / Elapsed : 0.0);
+		}
+
+		AbilityEffectSpecStats::SpecsCreatedPerClass.Reset();
+		AbilityEffectSpecStats::LastResetTime = Now;
+	})
+);
+#endif
+
+void UAG_GameplayAbility::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
+{
+	Super::OnGiveAbility(ActorInfo, Spec);
+
+	if (IsInstantiated() && ActorInfo && ActorInfo->AbilitySystemComponent.IsValid())
+	{
+		RefreshEffectSpecCache(Spec.Handle, ActorInfo);
+	}
+}
+
+void UAG_GameplayAbility::OnRemoveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
+{
+	ResetEffectSpecCache();
+
+	Super::OnRemoveAbility(ActorInfo, Spec);
+}
+
+FGameplayEffectSpecHandle UAG_GameplayAbility::MakeEffectSpec(UAbilitySystemComponent* AbilityComponent, TSubclassOf<UGameplayEffect> GameplayEffect, int32 Level, const FGameplayEffectContextHandle& EffectContext) const
+{
+	if (!GameplayEffect.Get()) return FGameplayEffectSpecHandle();
+
+	INC_DWORD_STAT(STAT_AbilityEffectSpecsCreated);
+#if !UE_BUILD_SHIPPING
+	AbilityEffectSpecStats::SpecsCreatedPerClass.FindOrAdd(GetClass()->GetFName())++;
+#endif
+
+	return AbilityComponent->MakeOutgoingSpec(GameplayEffect, Level, EffectContext);
+}
+
+void UAG_GameplayAbility::RefreshEffectSpecCache(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo)
+{
+	UAbilitySystemComponent* AbilityComponent = ActorInfo->AbilitySystemComponent.Get();
+	const int32 Level = GetAbilityLevel(Handle, ActorInfo);
+	const AActor* EffectCauser = ActorInfo->AvatarActor.Get();
+
+	const bool bCacheValid = CachedEffectSpecLevel == Level
+		&& CachedEffectCauser.Get() == EffectCauser
+		&& StartEffectSpecs.Num() == OngoingEffectsToJustApplyOnStart.Num()
+		&& RemoveOnEndEffectSpecs.Num() == OngoingEffectsToRemoveOnEnd.Num();
+
+	if (bCacheValid)
+	{
+		// Specs are reused as is; only snapshot source captures need to follow the owner's current attributes.
+		for (FGameplayEffectSpecHandle& SpecHandle : StartEffectSpecs)
+		{
+			if (SpecHandle.IsValid()) SpecHandle.Data->CaptureDataFromSource();
+		}
+
+		for (FGameplayEffectSpecHandle& SpecHandle : RemoveOnEndEffectSpecs)
+		{
+			if (SpecHandle.IsValid()) SpecHandle.Data->CaptureDataFromSource();
+		}
+
+		return;
+	}
+
+	const FGameplayEffectContextHandle EffectContext = AbilityComponent->MakeEffectContext();
+
+	StartEffectSpecs.Reset(OngoingEffectsToJustApplyOnStart.Num());
+	for (TSubclassOf<UGameplayEffect> GameplayEffect : OngoingEffectsToJustApplyOnStart)
+	{
+		StartEffectSpecs.Add(MakeEffectSpec(AbilityComponent, GameplayEffect, Level, EffectContext));
+	}
+
+	RemoveOnEndEffectSpecs.Reset(OngoingEffectsToRemoveOnEnd.Num());
+	for (TSubclassOf<UGameplayEffect> GameplayEffect : OngoingEffectsToRemoveOnEnd)
+	{
+		RemoveOnEndEffectSpecs.Add(MakeEffectSpec(AbilityComponent, GameplayEffect, Level, EffectContext));
+	}
+
+	CachedEffectSpecLevel = Level;
+	CachedEffectCauser = EffectCauser;
+}
+
+void UAG_GameplayAbility::ResetEffectSpecCache()
+{
+	StartEffectSpecs.Reset();
+	RemoveOnEndEffectSpecs.Reset();
+	CachedEffectSpecLevel = INDEX_NONE;
+	CachedEffectCauser.Reset();
+}
 
 void UAG_GameplayAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
 	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
-	FGameplayEffectContextHandle EffectContext = ActorInfo->AbilitySystemComponent->MakeEffectContext();
+	UAbilitySystemComponent* AbilityComponent = ActorInfo->AbilitySystemComponent.Get();
+	if (!AbilityComponent) return;
 
-	for (auto GameplayEffect : OngoingEffectsToJustApplyOnStart)
+	if (!IsInstantiated())
 	{
-		if (!GameplayEffect.Get()) continue;
+		const FGameplayEffectContextHandle EffectContext = AbilityComponent->MakeEffectContext();
+		const int32 Level = GetAbilityLevel(Handle, ActorInfo);
 
-		if (UAbilitySystemComponent* AbilityComponent = ActorInfo->AbilitySystemComponent.Get())
+		for (auto GameplayEffect : OngoingEffectsToJustApplyOnStart)
 		{
-			FGameplayEffectSpecHandle SpecHandle = AbilityComponent->MakeOutgoingSpec(GameplayEffect, 1, EffectContext);
+			FGameplayEffectSpecHandle SpecHandle = MakeEffectSpec(AbilityComponent, GameplayEffect, Level, EffectContext);
 			if (SpecHandle.IsValid())
 			{
 				FActiveGameplayEffectHandle ActiveGEHandle = AbilityComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
@@ -29,30 +142,37 @@ void UAG_GameplayAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handl
 				}
 			}
 		}
+
+		return;
 	}
 
-	if (IsInstantiated())
+	RefreshEffectSpecCache(Handle, ActorInfo);
+
+	for (int32 Index = 0; Index < StartEffectSpecs.Num(); ++Index)
 	{
-		for (auto GameplayEffect : OngoingEffectsToRemoveOnEnd)
+		const FGameplayEffectSpecHandle& SpecHandle = StartEffectSpecs[Index];
+		if (!SpecHandle.IsValid()) continue;
+
+		FActiveGameplayEffectHandle ActiveGEHandle = AbilityComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+		if (!ActiveGEHandle.WasSuccessfullyApplied())
 		{
-			if (!GameplayEffect.Get()) continue;
+			ABILITY_LOG(Log, TEXT("Ability %s failed to apply startup effect %s"), *GetName(), *GetNameSafe(OngoingEffectsToJustApplyOnStart[Index]));
+		}
+	}
 
-			if (UAbilitySystemComponent* AbilityComponent = ActorInfo->AbilitySystemComponent.Get())
-			{
-				FGameplayEffectSpecHandle SpecHandle = AbilityComponent->MakeOutgoingSpec(GameplayEffect, 1, EffectContext);
-				if (SpecHandle.IsValid())
-				{
-					FActiveGameplayEffectHandle ActiveGEHandle = AbilityComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
-					if (!ActiveGEHandle.WasSuccessfullyApplied())
-					{
-						ABILITY_LOG(Log, TEXT("Ability %s failed to apply runtime effect %s"), *GetName(), *GetNameSafe(GameplayEffect));
-					}
-					else
-					{
-						RemoveOnEndEffectHandles.Add(ActiveGEHandle);
-					}
-				}
-			}
+	for (int32 Index = 0; Index < RemoveOnEndEffectSpecs.Num(); ++Index)
+	{
+		const FGameplayEffectSpecHandle& SpecHandle = RemoveOnEndEffectSpecs[Index];
+		if (!SpecHandle.IsValid()) continue;
+
+		FActiveGameplayEffectHandle ActiveGEHandle = AbilityComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+		if (!ActiveGEHandle.WasSuccessfullyApplied())
+		{
+			ABILITY_LOG(Log, TEXT("Ability %s failed to apply runtime effect %s"), *GetName(), *GetNameSafe(OngoingEffectsToRemoveOnEnd[Index]));
+		}
+		else
+		{
+			RemoveOnEndEffectHandles.Add(ActiveGEHandle);
 		}
 	}
 }
@@ -17,6 +17,10 @@ public:
 
 	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled);
 
+	virtual void OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
+
+	virtual void OnRemoveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
+
 protected:
 
 	UPROPERTY(EditDefaultsOnly, Category = "Effects")
@@ -27,6 +31,22 @@ protected:
 	
 	TArray<FActiveGameplayEffectHandle> RemoveOnEndEffectHandles;
 
+	// Outgoing specs built once per ability instance, index-matched to the effect class arrays above.
+	// Non-instanced abilities have no per-actor storage and still build their specs on activation.
+	TArray<FGameplayEffectSpecHandle> StartEffectSpecs;
+
+	TArray<FGameplayEffectSpecHandle> RemoveOnEndEffectSpecs;
+
+	int32 CachedEffectSpecLevel = INDEX_NONE;
+
+	TWeakObjectPtr<const AActor> CachedEffectCauser;
+
+	void RefreshEffectSpecCache(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo);
+
+	void ResetEffectSpecCache();
+
+	FGameplayEffectSpecHandle MakeEffectSpec(UAbilitySystemComponent* AbilityComponent, TSubclassOf<UGameplayEffect> GameplayEffect, int32 Level, const FGameplayEffectContextHandle& EffectContext) const;
+
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	AActionGameCharacter* GetActionGameCharacterFromActorInfo() const;
 
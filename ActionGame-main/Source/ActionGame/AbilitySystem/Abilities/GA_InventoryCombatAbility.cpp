@@ -6,12 +6,14 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "ActionGameTypes.h"
+#include "ActionGameTags.h"
 
 #include "Inventory/ItemActors/WeaponItemActor.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "ActionGameCharacter.h"
 #include "Camera/CameraComponent.h"
 #include "ActorComponents/InventoryComponent.h"
+#include "ActionGameStats.h"
+#include "ActionGameQueries.h"
 
 bool UGA_InventoryCombatAbility::CommitAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, OUT FGameplayTagContainer* OptionalRelevantTags)
 {
@@ -60,7 +62,7 @@ FGameplayEffectSpecHandle UGA_InventoryCombatAbility::GetWeaponEffectSpec(const
 
 			FGameplayEffectSpecHandle OutSpec = AbilityComponent->MakeOutgoingSpec(WeaponStaticData->DamageEffect, 1, EffectContext);
 
-			UAbilitySystemBlueprintLibrary::AssignTagSetByCallerMagnitude(OutSpec, FGameplayTag::RequestGameplayTag(TEXT("Attribute.Health")), -WeaponStaticData->BaseDamage);
+			UAbilitySystemBlueprintLibrary::AssignTagSetByCallerMagnitude(OutSpec, ActionGameTags::Attribute_Health, -WeaponStaticData->BaseDamage);
 
 			return OutSpec;
 		}
@@ -79,17 +81,23 @@ const bool UGA_InventoryCombatAbility::GetWeaponToFocusTraceResult(float TraceDi
 
 	const FVector FocusTraceEnd = CameraTransform.GetLocation() + CameraTransform.GetRotation().Vector() * TraceDistance;
 
-	TArray<AActor*> ActorsToIgnore = {GetAvatarActorFromActorInfo()};
+	const UWorld* World = GetWorld();
+	const ECollisionChannel TraceChannel = UEngineTypes::ConvertToCollisionChannel(TraceType);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WeaponFocusTrace), false, GetAvatarActorFromActorInfo());
+	QueryParams.bReturnPhysicalMaterial = true;
 
 	FHitResult FocusHit;
 
-	UKismetSystemLibrary::LineTraceSingle(this, CameraTransform.GetLocation(), FocusTraceEnd, TraceType, false, ActorsToIgnore, EDrawDebugTrace::None, FocusHit, true);
+	ACTIONGAME_COUNT_TRACES(1);
+	ActionGameQueries::LineTraceSingleByChannel(World, FocusHit, CameraTransform.GetLocation(), FocusTraceEnd, TraceChannel, QueryParams);
 
 	FVector MuzzleLocation = WeaponItemActor->GetMuzzleLocation();
 
 	const FVector WeaponTraceEnd = MuzzleLocation + (FocusHit.Location - MuzzleLocation).GetSafeNormal() * TraceDistance;
 
-	UKismetSystemLibrary::LineTraceSingle(this, MuzzleLocation, WeaponTraceEnd, TraceType, false, ActorsToIgnore, EDrawDebugTrace::None, OutHitResult, true);
+	ACTIONGAME_COUNT_TRACES(1);
+	ActionGameQueries::LineTraceSingleByChannel(World, OutHitResult, MuzzleLocation, WeaponTraceEnd, TraceChannel, QueryParams);
 
 	return OutHitResult.bBlockingHit;
 }
\ No newline at end of file
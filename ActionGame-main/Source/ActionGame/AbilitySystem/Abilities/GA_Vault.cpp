@@ -4,12 +4,15 @@
 #include "AbilitySystem/Abilities/GA_Vault.h"
 
 #include "ActionGameCharacter.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "DrawDebugHelpers.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "ActorComponents/AG_MotionWarpingComponent.h"
+#include "ActionGameStats.h"
+#include "ActionGameQueries.h"
+
+DECLARE_CYCLE_STAT(TEXT("GA_Vault CommitCheck"), STAT_VaultCommitCheck, STATGROUP_ActionGame);
 
 UGA_Vault::UGA_Vault()
 {
@@ -17,8 +20,18 @@ UGA_Vault::UGA_Vault()
 	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
 }
 
+void UGA_Vault::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
+{
+	Super::OnGiveAbility(ActorInfo, Spec);
+
+	TraceObjectQueryParams = FCollisionObjectQueryParams(TraceObjectTypes);
+}
+
 bool UGA_Vault::CommitCheck(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, OUT FGameplayTagContainer* OptionalRelevantTags)
 {
+	SCOPE_CYCLE_COUNTER(STAT_VaultCommitCheck);
+	CSV_SCOPED_TIMING_STAT(ActionGame, VaultCommitCheck);
+
 	if (!Super::CommitCheck(Handle, ActorInfo, ActivationInfo, OptionalRelevantTags))
 	{
 		return false;
@@ -31,16 +44,51 @@ bool UGA_Vault::CommitCheck(const FGameplayAbilitySpecHandle Handle, const FGame
 		return false;
 	}
 
+	const FVector Location = Character->GetActorLocation();
+	const FVector Forward = Character->GetActorForwardVector();
+	const float Time = GetWorld()->GetTimeSeconds();
+
+	if (!CanReuseLedgeProfile(Location, Forward, Time))
+	{
+		LedgeProfile.bCanVault = ProbeLedge(Character);
+		LedgeProfile.ProbeLocation = Location;
+		LedgeProfile.ProbeForward = Forward;
+		LedgeProfile.ProbeTime = Time;
+		LedgeProfile.JumpToLocation = JumpToLocation;
+		LedgeProfile.JumpOverLocation = JumpOverLocation;
+		LedgeProfile.bIsValid = true;
+	}
+
+	JumpToLocation = LedgeProfile.JumpToLocation;
+	JumpOverLocation = LedgeProfile.JumpOverLocation;
+
+	return LedgeProfile.bCanVault;
+}
+
+bool UGA_Vault::CanReuseLedgeProfile(const FVector& Location, const FVector& Forward, float Time) const
+{
+	if (!LedgeProfile.bIsValid || Time - LedgeProfile.ProbeTime > LedgeProfileLifetime)
+	{
+		return false;
+	}
+
+	const bool bSameLocation = FVector::DistSquared(Location, LedgeProfile.ProbeLocation) <= FMath::Square(LedgeProfileMaxDistance);
+	const bool bSameFacing = FVector::DotProduct(Forward, LedgeProfile.ProbeForward) >= FMath::Cos(FMath::DegreesToRadians(LedgeProfileMaxYawDegrees));
+
+	return bSameLocation && bSameFacing;
+}
+
+bool UGA_Vault::ProbeLedge(AActionGameCharacter* Character)
+{
 	const FVector StartLocation = Character->GetActorLocation();
 	const FVector ForwardVector = Character->GetActorForwardVector();
 	const FVector UpVector = Character->GetActorUpVector();
 
-	TArray<AActor*> ActorsToIgnore = {Character};
+	const UWorld* World = GetWorld();
 
-	static const auto CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ShowDebugTraversal"));
-	const bool bShowTraversal = CVar->GetInt() > 0;
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(VaultProbe), true, Character);
 
-	EDrawDebugTrace::Type DebugDrawType = bShowTraversal ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None;
+	const bool bShowTraversal = ActionGameQueries::ShouldDrawDebug(CVarShowTraversal);
 
 	bool bJumpToLocationSet = false;
 
@@ -57,7 +105,8 @@ bool UGA_Vault::CommitCheck(const FGameplayAbilitySpecHandle Handle, const FGame
 		const FVector TraceStart = StartLocation + i * UpVector * HorizontalTraceStep;
 		const FVector TraceEnd = TraceStart + ForwardVector * HorizontalTraceLength;
 
-		if (UKismetSystemLibrary::SphereTraceSingleForObjects(this, TraceStart, TraceEnd, HorizontalTraceRadius, TraceObjectTypes, true, ActorsToIgnore, DebugDrawType, TraceHit, true))
+		ACTIONGAME_COUNT_TRACES(1);
+		if (ActionGameQueries::SphereTraceSingleByObjectType(World, TraceHit, TraceStart, TraceEnd, HorizontalTraceRadius, TraceObjectQueryParams, QueryParams, bShowTraversal))
 		{
 			if (JumpToLocationIdx == INDEX_NONE && (i < HorizontalTraceCount - 1))
 			{
@@ -113,7 +162,8 @@ bool UGA_Vault::CommitCheck(const FGameplayAbilitySpecHandle Handle, const FGame
 		const FVector TraceStart = VerticalStartLocation + i * ForwardVector * VerticalTraceStep;
 		const FVector TraceEnd = TraceStart + UpVector * VerticalTraceLength * -1;
 
-		if (UKismetSystemLibrary::SphereTraceSingleForObjects(this, TraceStart, TraceEnd, HorizontalTraceRadius, TraceObjectTypes, true, ActorsToIgnore, DebugDrawType, TraceHit, true))
+		ACTIONGAME_COUNT_TRACES(1);
+		if (ActionGameQueries::SphereTraceSingleByObjectType(World, TraceHit, TraceStart, TraceEnd, HorizontalTraceRadius, TraceObjectQueryParams, QueryParams, bShowTraversal))
 		{
 			JumpOverLocation = TraceHit.ImpactPoint;
 
@@ -136,15 +186,16 @@ bool UGA_Vault::CommitCheck(const FGameplayAbilitySpecHandle Handle, const FGame
 
 	const FVector TraceStart = JumpOverLocation + ForwardVector * VerticalTraceStep;
 
-	if (UKismetSystemLibrary::SphereTraceSingleForObjects(this, TraceStart, JumpOverLocation, HorizontalTraceRadius, TraceObjectTypes, true, ActorsToIgnore, DebugDrawType, TraceHit, true))
+	ACTIONGAME_COUNT_TRACES(1);
+	if (ActionGameQueries::SphereTraceSingleByObjectType(World, TraceHit, TraceStart, JumpOverLocation, HorizontalTraceRadius, TraceObjectQueryParams, QueryParams, bShowTraversal))
 	{
 		JumpOverLocation = TraceHit.ImpactPoint;
 	}
 
 	if (bShowTraversal)
 	{
-		DrawDebugSphere(GetWorld(), JumpToLocation, 15, 16, FColor::White, false, 7);
-		DrawDebugSphere(GetWorld(), JumpOverLocation, 15, 16, FColor::White, false, 7);
+		DrawDebugSphere(World, JumpToLocation, 15, 16, FColor::White, false, 7);
+		DrawDebugSphere(World, JumpOverLocation, 15, 16, FColor::White, false, 7);
 	}
 
 	return true;
@@ -7,6 +7,24 @@
 #include "GA_Vault.generated.h"
 
 class UAbilityTask_PlayMontageAndWait;
+class AActionGameCharacter;
+
+struct FVaultLedgeProfile
+{
+	bool bIsValid = false;
+
+	bool bCanVault = false;
+
+	FVector ProbeLocation = FVector::ZeroVector;
+
+	FVector ProbeForward = FVector::ZeroVector;
+
+	float ProbeTime = 0.f;
+
+	FVector JumpToLocation = FVector::ZeroVector;
+
+	FVector JumpOverLocation = FVector::ZeroVector;
+};
 
 UCLASS()
 class ACTIONGAME_API UGA_Vault : public UAG_GameplayAbility
@@ -15,6 +33,8 @@ class ACTIONGAME_API UGA_Vault : public UAG_GameplayAbility
 
 	UGA_Vault();
 
+	virtual void OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
+
 	virtual bool CommitCheck(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, OUT FGameplayTagContainer* OptionalRelevantTags = nullptr) override;
 
 	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
@@ -23,6 +43,10 @@ class ACTIONGAME_API UGA_Vault : public UAG_GameplayAbility
 
 protected:
 
+	bool ProbeLedge(AActionGameCharacter* Character);
+
+	bool CanReuseLedgeProfile(const FVector& Location, const FVector& Forward, float Time) const;
+
 	UPROPERTY(EditDefaultsOnly, Category = HorizontalTrace)
 	float HorizontalTraceRadius = 30.f;
 
@@ -44,6 +68,9 @@ protected:
 	UPROPERTY(EditDefaultsOnly)
 	TArray<TEnumAsByte<EObjectTypeQuery>> TraceObjectTypes;
 
+	// TraceObjectTypes converted once when the ability is given.
+	FCollisionObjectQueryParams TraceObjectQueryParams;
+
 	UPROPERTY(EditDefaultsOnly)
 	UAnimMontage* VaultMontage = nullptr;
 
@@ -53,6 +80,18 @@ protected:
 	FVector JumpToLocation;
 	FVector JumpOverLocation;
 
+	// Reuse the last probe result while the character stays within this distance of where it was taken.
+	UPROPERTY(EditDefaultsOnly, Category = LedgeProfileCache)
+	float LedgeProfileMaxDistance = 10.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = LedgeProfileCache)
+	float LedgeProfileMaxYawDegrees = 3.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = LedgeProfileCache)
+	float LedgeProfileLifetime = 0.5f;
+
+	FVaultLedgeProfile LedgeProfile;
+
 	UPROPERTY(EditDefaultsOnly)
 	TArray<TEnumAsByte<ECollisionChannel>> CollisionChannelsToIgnore;
 };
@@ -57,6 +57,8 @@ void UGA_WallRun::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const
 
 	WallRunTickTask = UAbilityTask_TickWallRun::CreateWallRunTask(this, Cast<ACharacter>(GetAvatarActorFromActorInfo()), Cast<UCharacterMovementComponent>(ActorInfo->MovementComponent), WallRun_TraceObjectTypes);
 
+	WallRunTickTask->SetWallRunData(WallRunDataAsset);
+
 	WallRunTickTask->OnFinished.AddDynamic(this, &UGA_WallRun::K2_EndAbility);
 	WallRunTickTask->OnWallSideDetermened.AddDynamic(this, &UGA_WallRun::OnWallSideDetermened);
 
@@ -8,6 +8,7 @@
 
 
 class UAbilityTask_TickWallRun;
+class UWallRunDataAsset;
 
 UCLASS()
 class ACTIONGAME_API UGA_WallRun : public UAG_GameplayAbility
@@ -40,6 +41,9 @@ protected:
 	UPROPERTY(EditDefaultsOnly)
 	TArray<TEnumAsByte<EObjectTypeQuery>> WallRun_TraceObjectTypes;
 
+	UPROPERTY(EditDefaultsOnly)
+	UWallRunDataAsset* WallRunDataAsset = nullptr;
+
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<UGameplayEffect> WallRunLeftSideEffectClass;
 
@@ -6,17 +6,25 @@
 #include "Gameframework/Character.h"
 #include "Gameframework/CharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
-#include "Kismet/KismetSystemLibrary.h"
+#include "DataAssets/WallRunDataAsset.h"
+#include "DrawDebugHelpers.h"
+#include "ActionGameStats.h"
+#include "ActionGameQueries.h"
+
+DECLARE_CYCLE_STAT(TEXT("TickWallRun TickTask"), STAT_WallRunTickTask, STATGROUP_ActionGame);
 
 void UAbilityTask_TickWallRun::Activate()
 {
 	Super::Activate();
 
-	FHitResult OnWallHit;
+	WallQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(WallRunProbe), true, CharacterOwner);
+	WallQueryParams.bReturnPhysicalMaterial = true;
+
+	WallObjectQueryParams = FCollisionObjectQueryParams(WallRun_TraceObjectTypes);
 
-	//const FVector CurrentAcceleration = CharacterMovement->GetCurrentAcceleration();
+	bShowDebug = ActionGameQueries::ShouldDrawDebug(CVarShowTraversal);
 
-	if (!FindRunnableWall(OnWallHit))
+	if (!FindRunnableWall(WallHit))
 	{
 		if (ShouldBroadcastAbilityTaskDelegates())
 		{
@@ -28,15 +36,23 @@ void UAbilityTask_TickWallRun::Activate()
 		return;
 	}
 
-	OnWallSideDetermened.Broadcast(IsWallOnTheLeft(OnWallHit));
+	bWallOnTheLeft = IsWallOnTheLeft(WallHit);
+
+	OnWallSideDetermened.Broadcast(bWallOnTheLeft);
 
-	CharacterOwner->Landed(OnWallHit);
+	CharacterOwner->Landed(WallHit);
 
-	CharacterOwner->SetActorLocation(OnWallHit.ImpactPoint + OnWallHit.ImpactNormal * 60.f);
+	CharacterOwner->SetActorLocation(WallHit.ImpactPoint + WallHit.ImpactNormal * WallRunData.WallOffset);
+
+	LastProbeLocation = CharacterOwner->GetActorLocation();
 
 	CharacterMovement->SetMovementMode(MOVE_Flying);
 
-	CharacterMovement->GravityScale = 0.2f;
+	CharacterMovement->GravityScale = WallRunData.WallRunGravityScale;
+
+	CharacterMovement->SetPlaneConstraintEnabled(true);
+	CharacterMovement->SetPlaneConstraintOrigin(WallHit.ImpactPoint);
+	CharacterMovement->SetPlaneConstraintNormal(WallHit.ImpactNormal);
 }
 
 UAbilityTask_TickWallRun* UAbilityTask_TickWallRun::CreateWallRunTask(UGameplayAbility* OwningAbility, ACharacter* InCharacterOwner, UCharacterMovementComponent* InCharacterMovement, TArray<TEnumAsByte<EObjectTypeQuery>> TraceObjectTypes)
@@ -51,39 +67,70 @@ UAbilityTask_TickWallRun* UAbilityTask_TickWallRun::CreateWallRunTask(UGameplayA
 	return WallRunTask;
 }
 
+void UAbilityTask_TickWallRun::SetWallRunData(const UWallRunDataAsset* InWallRunDataAsset)
+{
+	if (InWallRunDataAsset)
+	{
+		WallRunData = InWallRunDataAsset->WallRunData;
+	}
+}
+
 void UAbilityTask_TickWallRun::TickTask(float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_WallRunTickTask);
+	CSV_SCOPED_TIMING_STAT(ActionGame, WallRunTickTask);
+
 	Super::TickTask(DeltaTime);
 
-	FHitResult OnWallHit;
+	const FVector CharacterLocation = CharacterOwner->GetActorLocation();
 
-	//const FVector CurrentAcceleration = CharacterMovement->GetCurrentAcceleration();
+	// The wall hit stays valid until the character moved far enough along it for the wall to possibly have ended.
+	const FVector LateralDelta = FVector::VectorPlaneProject(CharacterLocation - LastProbeLocation, WallHit.ImpactNormal);
 
-	if (!FindRunnableWall(OnWallHit))
+	if (LateralDelta.SizeSquared2D() >= FMath::Square(WallRunData.ReprobeDistance))
 	{
-		if (ShouldBroadcastAbilityTaskDelegates())
+		if (!FindRunnableWallOnSide(WallHit))
 		{
-			OnFinished.Broadcast();
+			if (ShouldBroadcastAbilityTaskDelegates())
+			{
+				OnFinished.Broadcast();
+			}
+
+			EndTask();
+
+			return;
 		}
 
-		EndTask();
+		LastProbeLocation = CharacterLocation;
 
-		return;
+		CharacterMovement->SetPlaneConstraintOrigin(WallHit.ImpactPoint);
+		CharacterMovement->SetPlaneConstraintNormal(WallHit.ImpactNormal);
 	}
 
-	const FRotator DirectionRotator = IsWallOnTheLeft(OnWallHit) ? FRotator(0, -90, 0) : FRotator(0, 90, 0);
-
-	const FVector WallRunDirection = DirectionRotator.RotateVector(OnWallHit.ImpactNormal);
+	const FRotator DirectionRotator = bWallOnTheLeft ? FRotator(0, -90, 0) : FRotator(0, 90, 0);
 
-	const float CachedZ = CharacterMovement->Velocity.Z;
+	const FVector WallRunDirection = DirectionRotator.RotateVector(WallHit.ImpactNormal);
 
-	CharacterMovement->Velocity = WallRunDirection * 700.f;
+	CharacterMovement->Velocity = WallRunDirection * WallRunData.WallRunSpeed;
 
 	CharacterMovement->Velocity.Z = 0;
+}
 
-	CharacterMovement->SetPlaneConstraintEnabled(true);
-	CharacterMovement->SetPlaneConstraintOrigin(OnWallHit.ImpactPoint);
-	CharacterMovement->SetPlaneConstraintNormal(OnWallHit.ImpactNormal);
+bool UAbilityTask_TickWallRun::ProbeWall(const FVector& InStart, const FVector& InDirection, float InLength, FHitResult& OutHit) const
+{
+	const FVector End = InStart + InDirection * InLength;
+
+	ACTIONGAME_COUNT_TRACES(1);
+	const bool bHit = GetWorld()->LineTraceSingleByObjectType(OutHit, InStart, End, WallObjectQueryParams, WallQueryParams);
+
+#if ACTIONGAME_DEBUG_DRAW
+	if (bShowDebug)
+	{
+		DrawDebugLine(GetWorld(), InStart, bHit ? OutHit.ImpactPoint : End, bHit ? FColor::Red : FColor::Green, false, 5.f);
+	}
+#endif
+
+	return bHit;
 }
 
 bool UAbilityTask_TickWallRun::FindRunnableWall(FHitResult& OnWallHit)
@@ -93,33 +140,24 @@ bool UAbilityTask_TickWallRun::FindRunnableWall(FHitResult& OnWallHit)
 	const FVector RightVector = CharacterOwner->GetActorRightVector();
 	const FVector ForwardVector = CharacterOwner->GetActorForwardVector();
 
-	const float TraceLength = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius() + 30.f;
+	const float TraceLength = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius() + WallRunData.ProbeExtraLength;
 
-	TArray<AActor*> ActorsToIgnore = {CharacterOwner};
-
-	FHitResult TraceHit;
-
-	static const auto CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ShowDebugTraversal"));
-	const bool bShowTraversal = CVar->GetInt() > 0;
-
-	EDrawDebugTrace::Type DebugDrawType = bShowTraversal ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None;
-
-	if (UKismetSystemLibrary::LineTraceSingleForObjects(GetWorld(), CharacterLocation, CharacterLocation + ForwardVector * TraceLength, WallRun_TraceObjectTypes, true, ActorsToIgnore, DebugDrawType, OnWallHit, true))
+	if (ProbeWall(CharacterLocation, ForwardVector, TraceLength, OnWallHit))
 	{
 		return false;
 	}
 
-	if (UKismetSystemLibrary::LineTraceSingleForObjects(GetWorld(), CharacterLocation, CharacterLocation + -RightVector * TraceLength, WallRun_TraceObjectTypes, true, ActorsToIgnore, DebugDrawType, OnWallHit, true))
+	if (ProbeWall(CharacterLocation, -RightVector, TraceLength, OnWallHit))
 	{
-		if (FVector::DotProduct(OnWallHit.ImpactNormal, RightVector) > 0.3f)
+		if (FVector::DotProduct(OnWallHit.ImpactNormal, RightVector) > WallRunData.MinWallNormalDot)
 		{
 			return true;
 		}
 	}
 
-	if (UKismetSystemLibrary::LineTraceSingleForObjects(GetWorld(), CharacterLocation, CharacterLocation + RightVector * TraceLength, WallRun_TraceObjectTypes, true, ActorsToIgnore, DebugDrawType, OnWallHit, true))
+	if (ProbeWall(CharacterLocation, RightVector, TraceLength, OnWallHit))
 	{
-		if (FVector::DotProduct(OnWallHit.ImpactNormal, -RightVector) > 0.3f)
+		if (FVector::DotProduct(OnWallHit.ImpactNormal, -RightVector) > WallRunData.MinWallNormalDot)
 		{
 			return true;
 		}
@@ -128,6 +166,23 @@ bool UAbilityTask_TickWallRun::FindRunnableWall(FHitResult& OnWallHit)
 	return false;
 }
 
+bool UAbilityTask_TickWallRun::FindRunnableWallOnSide(FHitResult& OnWallHit) const
+{
+	const FVector CharacterLocation = CharacterOwner->GetActorLocation();
+
+	const FVector SideVector = bWallOnTheLeft ? -CharacterOwner->GetActorRightVector() : CharacterOwner->GetActorRightVector();
+	const FVector ForwardVector = CharacterOwner->GetActorForwardVector();
+
+	const float TraceLength = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius() + WallRunData.ProbeExtraLength;
+
+	if (ProbeWall(CharacterLocation, ForwardVector, TraceLength, OnWallHit))
+	{
+		return false;
+	}
+
+	return ProbeWall(CharacterLocation, SideVector, TraceLength, OnWallHit) && FVector::DotProduct(OnWallHit.ImpactNormal, -SideVector) > WallRunData.MinWallNormalDot;
+}
+
 bool UAbilityTask_TickWallRun::IsWallOnTheLeft(const FHitResult& InWallHit) const
 {
 	return FVector::DotProduct(CharacterOwner->GetActorRightVector(), InWallHit.ImpactNormal) > 0.f;
@@ -139,7 +194,7 @@ void UAbilityTask_TickWallRun::OnDestroy(bool bInOwnerFinished)
 
 	CharacterMovement->SetMovementMode(MOVE_Falling);
 
-	CharacterMovement->GravityScale = 1.75f;
+	CharacterMovement->GravityScale = WallRunData.EndGravityScale;
 
 	Super::OnDestroy(bInOwnerFinished);
 }
\ No newline at end of file
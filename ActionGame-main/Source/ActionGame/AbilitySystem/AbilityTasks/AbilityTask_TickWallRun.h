@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Abilities/Tasks/AbilityTask.h"
+#include "ActionGameTypes.h"
 #include "AbilityTask_TickWallRun.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWallRunWallSideDetermenedDelegate, bool, bLeftSide);
@@ -12,6 +13,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnWallRunFinishedDelegate);
 
 class ACharacter;
 class UCharacterMovementComponent;
+class UWallRunDataAsset;
 
 UCLASS()
 class ACTIONGAME_API UAbilityTask_TickWallRun : public UAbilityTask
@@ -35,6 +37,9 @@ public:
 
 	virtual void TickTask(float DeltaTime) override;
 
+	// Falls back to the FWallRunData defaults when not set.
+	void SetWallRunData(const UWallRunDataAsset* InWallRunDataAsset);
+
 protected:
 
 	UCharacterMovementComponent* CharacterMovement = nullptr;
@@ -43,8 +48,29 @@ protected:
 
 	TArray<TEnumAsByte<EObjectTypeQuery>> WallRun_TraceObjectTypes;
 
+	FWallRunData WallRunData;
+
+	// Built once in Activate and reused by every probe.
+	FCollisionQueryParams WallQueryParams;
+
+	FCollisionObjectQueryParams WallObjectQueryParams;
+
+	bool bShowDebug = false;
+
+	bool bWallOnTheLeft = false;
+
+	FHitResult WallHit;
+
+	FVector LastProbeLocation = FVector::ZeroVector;
+
+	bool ProbeWall(const FVector& InStart, const FVector& InDirection, float InLength, FHitResult& OutHit) const;
+
+	// Probes ahead and on both sides, used to pick the wall when the task starts.
 	bool FindRunnableWall(FHitResult& OnWallHit);
 
+	// Probes ahead and only on the side of the wall being run on.
+	bool FindRunnableWallOnSide(FHitResult& OnWallHit) const;
+
 	bool IsWallOnTheLeft(const FHitResult& InWallHit) const;
 
 };
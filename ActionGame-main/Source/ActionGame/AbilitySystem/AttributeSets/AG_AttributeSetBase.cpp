@@ -29,6 +29,41 @@ void UAG_AttributeSetBase::PostGameplayEffectExecute(const struct FGameplayEffec
 	}
 }
 
+void UAG_AttributeSetBase::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+
+	if (Attribute == GetHealthAttribute() || Attribute == GetMaxHealthAttribute())
+	{
+		const AActor* OwningActor = GetOwningActor();
+		if (OwningActor && OwningActor->HasAuthority())
+		{
+			UpdateSimulatedHealthStep();
+		}
+	}
+}
+
+void UAG_AttributeSetBase::UpdateSimulatedHealthStep()
+{
+	const float MaxHealthValue = GetMaxHealth();
+	const float HealthFraction = MaxHealthValue > 0.f ? FMath::Clamp(GetHealth() / MaxHealthValue, 0.f, 1.f) : 0.f;
+
+	SimulatedHealthStep = static_cast<uint8>(FMath::CeilToInt(HealthFraction * SimulatedHealthSteps));
+}
+
+void UAG_AttributeSetBase::ApplySimulatedHealthStep()
+{
+	const FGameplayAttributeData OldHealth = Health;
+	const float NewHealth = GetMaxHealth() * SimulatedHealthStep / SimulatedHealthSteps;
+
+	if (FMath::IsNearlyEqual(OldHealth.GetBaseValue(), NewHealth)) return;
+
+	Health.SetBaseValue(NewHealth);
+	Health.SetCurrentValue(NewHealth);
+
+	GAMEPLAYATTRIBUTE_REPNOTIFY(UAG_AttributeSetBase, Health, OldHealth);
+}
+
 UFUNCTION()
 void UAG_AttributeSetBase::OnRep_Health(const FGameplayAttributeData& OldHealth)
 {
@@ -39,6 +74,13 @@ UFUNCTION()
 void UAG_AttributeSetBase::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UAG_AttributeSetBase, MaxHealth, OldMaxHealth);
+
+	// Simulated proxies only know health relative to max health.
+	const AActor* OwningActor = GetOwningActor();
+	if (OwningActor && OwningActor->GetLocalRole() == ROLE_SimulatedProxy)
+	{
+		ApplySimulatedHealthStep();
+	}
 }
 
 void UAG_AttributeSetBase::OnRep_Stamina(const FGameplayAttributeData& OldStamina)
@@ -56,13 +98,22 @@ void UAG_AttributeSetBase::OnRep_MaxMovementSpeed(const FGameplayAttributeData&
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UAG_AttributeSetBase, MaxMovementSpeed, OldMaxMovementSpeed);
 }
 
+void UAG_AttributeSetBase::OnRep_SimulatedHealthStep()
+{
+	ApplySimulatedHealthStep();
+}
+
 void UAG_AttributeSetBase::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION_NOTIFY(UAG_AttributeSetBase, Health, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAG_AttributeSetBase, MaxHealth, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAG_AttributeSetBase, Stamina, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAG_AttributeSetBase, MaxStamina, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAG_AttributeSetBase, MaxMovementSpeed, COND_None, REPNOTIFY_Always);
+	// Attributes the owner predicts keep REPNOTIFY_Always so a server value equal to the predicted one still reconciles.
+	// Simulated proxies get health as a quantized step and never see stamina or movement speed,
+	// which change every frame while sprinting and are only needed by the owner.
+	DOREPLIFETIME_CONDITION_NOTIFY(UAG_AttributeSetBase, Health, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UAG_AttributeSetBase, MaxHealth, COND_None, REPNOTIFY_OnChanged);
+	DOREPLIFETIME_CONDITION_NOTIFY(UAG_AttributeSetBase, Stamina, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UAG_AttributeSetBase, MaxStamina, COND_OwnerOnly, REPNOTIFY_OnChanged);
+	DOREPLIFETIME_CONDITION_NOTIFY(UAG_AttributeSetBase, MaxMovementSpeed, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION(UAG_AttributeSetBase, SimulatedHealthStep, COND_SkipOwner);
 }
\ No newline at end of file
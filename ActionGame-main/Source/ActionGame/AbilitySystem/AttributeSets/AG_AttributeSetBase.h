@@ -43,8 +43,21 @@ public:
 
 protected:
 
+	// Health quantized to this many steps for simulated proxies. Any non-zero health maps to at least one step so death stays exact.
+	static constexpr int32 SimulatedHealthSteps = 255;
+
+	// Replaces Health on non-owning connections; only dirtied when the quantized step changes.
+	UPROPERTY(ReplicatedUsing = OnRep_SimulatedHealthStep)
+	uint8 SimulatedHealthStep = SimulatedHealthSteps;
+
 	virtual void PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData &Data) override;
 
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+
+	void UpdateSimulatedHealthStep();
+
+	void ApplySimulatedHealthStep();
+
 	UFUNCTION()
 	virtual void OnRep_Health(const FGameplayAttributeData& OldHealth);
 
@@ -59,4 +72,7 @@ protected:
 
 	UFUNCTION()
 	virtual void OnRep_MaxMovementSpeed(const FGameplayAttributeData& OldMaxMovementSpeed);
+
+	UFUNCTION()
+	virtual void OnRep_SimulatedHealthStep();
 };
@@ -1,7 +1,12 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ActionGame.h"
+#include "ActionGameStats.h"
 #include "Modules/ModuleManager.h"
 
+CSV_DEFINE_CATEGORY_MODULE(ACTIONGAME_API, ActionGame, true);
+
+DEFINE_STAT(STAT_ActionGameTracesIssued);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ActionGame, "ActionGame" );
  
\ No newline at end of file
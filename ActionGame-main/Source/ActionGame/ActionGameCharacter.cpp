@@ -11,6 +11,7 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystem/AttributeSets/AG_AttributeSetBase.h"
+#include "ActionGameTags.h"
 #include "DataAssets/CharacterDataAsset.h"
 #include "AbilitySystem/Components/AG_AbilitySystemComponentBase.h"
 
@@ -19,6 +20,7 @@
 #include "ActorComponents/AG_CharacterMovementComponent.h"
 #include "ActorComponents/FootstepsComponent.h"
 #include "ActorComponents/InventoryComponent.h"
+#include "Subsystems/RagdollSubsystem.h"
 
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
@@ -35,6 +37,9 @@
 AActionGameCharacter::AActionGameCharacter(const FObjectInitializer& ObjectInitializer) :
 	Super(ObjectInitializer.SetDefaultSubobjectClass<UAG_CharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
+	// Components (inventory, ability system) replicate their subobjects through registered lists.
+	bReplicateUsingRegisteredSubObjectList = true;
+
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(42.f, 96.0f);
 
@@ -59,6 +64,7 @@ AActionGameCharacter::AActionGameCharacter(const FObjectInitializer& ObjectIniti
 	GetCharacterMovement()->BrakingDecelerationWalking = 2000.f;
 
 	AGCharacterMovementComponent = Cast<UAG_CharacterMovementComponent>(GetCharacterMovement());
+	AGCharacterMovementComponent->OnClimbEnded.AddUObject(this, &AActionGameCharacter::OnEndClimb);
 
 	// Create a camera boom (pulls in towards the player if there is a collision)
 	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
@@ -86,7 +92,7 @@ AActionGameCharacter::AActionGameCharacter(const FObjectInitializer& ObjectIniti
 
 	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AttributeSet->GetHealthAttribute()).AddUObject(this, &AActionGameCharacter::OnHealthAttributeChanged);
 
-	AbilitySystemComponent->RegisterGameplayTagEvent(FGameplayTag::RequestGameplayTag(TEXT("State.Ragdoll")), EGameplayTagEventType::NewOrRemoved).AddUObject(this, &AActionGameCharacter::OnRagdollStateTagChanged);
+	AbilitySystemComponent->RegisterGameplayTagEvent(ActionGameTags::State_Ragdoll, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &AActionGameCharacter::OnRagdollStateTagChanged);
 
 	FootstepsComponent = CreateDefaultSubobject<UFootstepsComponent>(TEXT("FootstepsComponent"));
 
@@ -142,13 +148,13 @@ void AActionGameCharacter::StartRagdoll()
 
 	if (SkeletalMesh && !SkeletalMesh->IsSimulatingPhysics())
 	{
-		SkeletalMesh->SetCollisionProfileName(TEXT("Ragdoll"));
-		SkeletalMesh->SetSimulatePhysics(true);
-		SkeletalMesh->SetAllPhysicsLinearVelocity(FVector::ZeroVector);
-		SkeletalMesh->SetAllPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
-		SkeletalMesh->WakeAllRigidBodies();
-		GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		// The subsystem decides whether the mesh simulates at all, the capsule stops blocking either way.
+		if (URagdollSubsystem* RagdollSubsystem = GetWorld()->GetSubsystem<URagdollSubsystem>())
+		{
+			RagdollSubsystem->StartRagdoll(SkeletalMesh);
+		}
 
+		GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	}
 }
 
@@ -565,6 +571,8 @@ void AActionGameCharacter::SetCharacterData(const FCharacterData& InCharacterDat
 	CharacterData = InCharacterData;
 
 	InitFromCharacterData(CharacterData);
+
+	OnCharacterDataChanged.Broadcast();
 }
 
 void AActionGameCharacter::InitFromCharacterData(const FCharacterData& InCharacterData, bool bFromReplication)
@@ -575,6 +583,8 @@ void AActionGameCharacter::InitFromCharacterData(const FCharacterData& InCharact
 void AActionGameCharacter::OnRep_CharacterData()
 {
 	InitFromCharacterData(CharacterData, true);
+
+	OnCharacterDataChanged.Broadcast();
 }
 
 UFootstepsComponent* AActionGameCharacter::GetFootstepsComponent() const
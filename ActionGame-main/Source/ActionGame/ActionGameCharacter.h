@@ -21,6 +21,8 @@ class UAG_MotionWarpingComponent;
 class UAG_CharacterMovementComponent;
 class UInventoryComponent;
 
+DECLARE_MULTICAST_DELEGATE(FOnCharacterDataChangedDelegate);
+
 UCLASS(config=Game)
 class AActionGameCharacter : public ACharacter, public IAbilitySystemInterface
 {
@@ -112,6 +114,9 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void SetCharacterData(const FCharacterData& InCharacterData);
 
+	// Broadcast on the server when the character data is set and on clients when it replicates.
+	FOnCharacterDataChangedDelegate OnCharacterDataChanged;
+
 	class UFootstepsComponent* GetFootstepsComponent() const;
 
 	void OnMaxMovementSpeedChanged(const FOnAttributeChangeData& Data);
@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ActionGameQueries.h"
+
+#include "Engine/World.h"
+#include "DrawDebugHelpers.h"
+#include "Volumes/AbilitySystemPhysicsVolume.h"
+#include "ActorComponents/InventoryComponent.h"
+#include "UObject/UObjectIterator.h"
+
+TAutoConsoleVariable<int32> CVarShowTraversal(
+	TEXT("ShowDebugTraversal"),
+	0,
+	TEXT("Draws debug info about traversal")
+	TEXT(" 0: off/n")
+	TEXT(" 1: on/n"),
+	ECVF_Cheat
+);
+
+TAutoConsoleVariable<int32> CVarShowInventory(
+	TEXT("ShowDebugInventory"),
+	0,
+	TEXT("Draws debug info about inventory")
+	TEXT(" 0: off/n")
+	TEXT(" 1: on/n"),
+	FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*)
+	{
+		for (TObjectIterator<UInventoryComponent> It; It; ++It)
+		{
+			if (It->HasBegunPlay())
+			{
+				It->UpdateTickEnabled();
+			}
+		}
+	}),
+	ECVF_Cheat
+);
+
+TAutoConsoleVariable<int32> CVarShowRadialDamage(
+	TEXT("ShowRadialDamage"),
+	0,
+	TEXT("Draws debug info about radial damage")
+	TEXT(" 0: off/n")
+	TEXT(" 1: on/n"),
+	ECVF_Cheat
+);
+
+TAutoConsoleVariable<int32> CVarShowProjectiles(
+	TEXT("ShowDebugProjectiles"),
+	0,
+	TEXT("Draws debug info about projectiles")
+	TEXT(" 0: off/n")
+	TEXT(" 1: on/n"),
+	ECVF_Cheat
+);
+
+TAutoConsoleVariable<int32> CVarShowFootsteps(
+	TEXT("ShowDebugFootsteps"),
+	0,
+	TEXT("Draws debug info about footsteps")
+	TEXT("  0: off/n")
+	TEXT("  1: on/n"),
+	ECVF_Cheat);
+
+TAutoConsoleVariable<int32> CVarShowAbilityVolumes(
+	TEXT("ShowDebugAbilityVolumes"),
+	0,
+	TEXT("Draws debug info about ability system volumes")
+	TEXT(" 0: off/n")
+	TEXT(" 1: on/n"),
+	FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*)
+	{
+		for (TObjectIterator<AAbilitySystemPhysicsVolume> It; It; ++It)
+		{
+			if (It->HasActorBegunPlay())
+			{
+				It->UpdateTickEnabled();
+			}
+		}
+	}),
+	ECVF_Cheat
+);
+
+namespace ActionGameQueries
+{
+	const FName ItemDropProfileName = TEXT("WorldStatic");
+
+	static constexpr float DebugDrawTime = 5.f;
+
+	bool SphereTraceSingleByObjectType(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, float Radius,
+		const FCollisionObjectQueryParams& ObjectParams, const FCollisionQueryParams& Params, bool bDrawDebug)
+	{
+		const bool bHit = World->SweepSingleByObjectType(OutHit, Start, End, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Radius), Params);
+
+#if ACTIONGAME_DEBUG_DRAW
+		if (bDrawDebug)
+		{
+			DrawDebugLine(World, Start, End, bHit ? FColor::Red : FColor::Green, false, DebugDrawTime);
+
+			if (bHit)
+			{
+				DrawDebugSphere(World, OutHit.Location, Radius, 12, FColor::Red, false, DebugDrawTime);
+				DrawDebugPoint(World, OutHit.ImpactPoint, 16.f, FColor::Green, false, DebugDrawTime);
+			}
+		}
+#endif
+
+		return bHit;
+	}
+
+	bool LineTraceSingleByChannel(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, ECollisionChannel Channel,
+		const FCollisionQueryParams& Params, bool bDrawDebug)
+	{
+		const bool bHit = World->LineTraceSingleByChannel(OutHit, Start, End, Channel, Params);
+
+#if ACTIONGAME_DEBUG_DRAW
+		if (bDrawDebug)
+		{
+			DrawDebugLine(World, Start, bHit ? OutHit.ImpactPoint : End, bHit ? FColor::Red : FColor::Green, false, DebugDrawTime);
+		}
+#endif
+
+		return bHit;
+	}
+
+	bool LineTraceSingleByProfile(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, FName ProfileName,
+		const FCollisionQueryParams& Params, bool bDrawDebug)
+	{
+		const bool bHit = World->LineTraceSingleByProfile(OutHit, Start, End, ProfileName, Params);
+
+#if ACTIONGAME_DEBUG_DRAW
+		if (bDrawDebug)
+		{
+			DrawDebugLine(World, Start, bHit ? OutHit.ImpactPoint : End, bHit ? FColor::Red : FColor::Green, false, DebugDrawTime);
+		}
+#endif
+
+		return bHit;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "CollisionQueryParams.h"
+#include "Engine/EngineTypes.h"
+
+// Debug drawing of game queries, compiled out of Shipping and Test builds.
+#define ACTIONGAME_DEBUG_DRAW (ENABLE_DRAW_DEBUG && !(UE_BUILD_SHIPPING || UE_BUILD_TEST))
+
+// Debug flags, defined once here so call sites read them directly instead of looking them up by name.
+extern ACTIONGAME_API TAutoConsoleVariable<int32> CVarShowTraversal;
+extern ACTIONGAME_API TAutoConsoleVariable<int32> CVarShowInventory;
+extern ACTIONGAME_API TAutoConsoleVariable<int32> CVarShowRadialDamage;
+extern ACTIONGAME_API TAutoConsoleVariable<int32> CVarShowProjectiles;
+extern ACTIONGAME_API TAutoConsoleVariable<int32> CVarShowFootsteps;
+extern ACTIONGAME_API TAutoConsoleVariable<int32> CVarShowAbilityVolumes;
+
+class UWorld;
+
+namespace ActionGameQueries
+{
+	// Profile the ground under dropped items is found with.
+	extern ACTIONGAME_API const FName ItemDropProfileName;
+
+	// Always false where debug drawing is compiled out, so the drawing behind it is stripped as well.
+	inline bool ShouldDrawDebug(const TAutoConsoleVariable<int32>& InCVar)
+	{
+#if ACTIONGAME_DEBUG_DRAW
+		return InCVar.GetValueOnGameThread() > 0;
+#else
+		return false;
+#endif
+	}
+
+	ACTIONGAME_API bool SphereTraceSingleByObjectType(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, float Radius,
+		const FCollisionObjectQueryParams& ObjectParams, const FCollisionQueryParams& Params, bool bDrawDebug = false);
+
+	ACTIONGAME_API bool LineTraceSingleByChannel(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, ECollisionChannel Channel,
+		const FCollisionQueryParams& Params, bool bDrawDebug = false);
+
+	ACTIONGAME_API bool LineTraceSingleByProfile(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, FName ProfileName,
+		const FCollisionQueryParams& Params, bool bDrawDebug = false);
+}
\ No newline at end of file
@@ -3,19 +3,18 @@
 
 #include "ActionGameStatics.h"
 
-#include "Kismet/KismetSystemLibrary.h"
 #include "AbilitySystemComponent.h"
-#include "Actors/Projectile.h"
+#include "Subsystems/ProjectileSubsystem.h"
 #include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemGlobals.h"
+#include "GameplayEffect.h"
+#include "ActionGameTags.h"
+#include "Engine/OverlapResult.h"
+#include "DrawDebugHelpers.h"
+#include "ActionGameStats.h"
+#include "ActionGameQueries.h"
 
-static TAutoConsoleVariable<int32> CVarShowRadialDamage(
-	TEXT("ShowRadialDamage"),
-	0,
-	TEXT("Draws debug info about radial damage")
-	TEXT(" 0: off/n")
-	TEXT(" 1: on/n"),
-	ECVF_Cheat
-);
+DECLARE_CYCLE_STAT(TEXT("ApplyRadialDamage"), STAT_ApplyRadialDamage, STATGROUP_ActionGame);
 
 const UItemStaticData* UActionGameStatics::GetItemStaticData(TSubclassOf<UItemStaticData> ItemDataClass)
 {
@@ -30,96 +29,119 @@ const UItemStaticData* UActionGameStatics::GetItemStaticData(TSubclassOf<UItemSt
 void UActionGameStatics::ApplyRadialDamage(UObject* WorldContextObject, AActor* DamageCauser, FVector Location, float Radius, float DamageAmount, TArray<TSubclassOf<class UGameplayEffect>> DamageEffects,
 	const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes, ETraceTypeQuery TraceType)
 {
-	TArray<AActor*> OutActors;
-	TArray<AActor*> ActorsToIgnore = {DamageCauser};
+	SCOPE_CYCLE_COUNTER(STAT_ApplyRadialDamage);
+	CSV_SCOPED_TIMING_STAT(ActionGame, ApplyRadialDamage);
 
-	UKismetSystemLibrary::SphereOverlapActors(WorldContextObject, Location, Radius, ObjectTypes, nullptr, ActorsToIgnore, OutActors);
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
 
-	const bool bDebug = static_cast<bool>(CVarShowRadialDamage.GetValueOnAnyThread());
-
-	for (AActor* Actor : OutActors)
+	if (!World)
 	{
-		FHitResult HitResult;
+		return;
+	}
+
+	const bool bDebug = ActionGameQueries::ShouldDrawDebug(CVarShowRadialDamage);
+
+	TArray<FOverlapResult> Overlaps;
+	FCollisionQueryParams OverlapParams(SCENE_QUERY_STAT(ApplyRadialDamageOverlap), false, DamageCauser);
+
+	ACTIONGAME_COUNT_TRACES(1);
+	World->OverlapMultiByObjectType(Overlaps, Location, FQuat::Identity, FCollisionObjectQueryParams(ObjectTypes), FCollisionShape::MakeSphere(Radius), OverlapParams);
 
-		if (UKismetSystemLibrary::LineTraceSingle(WorldContextObject, Location, Actor->GetActorLocation(), TraceType, true, ActorsToIgnore, EDrawDebugTrace::None, HitResult, true))
+	// Overlaps are per component, damage is applied once per actor.
+	TArray<AActor*, TInlineAllocator<16>> OverlappedActors;
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		if (AActor* OverlappedActor = Overlap.GetActor())
 		{
-			AActor* Target = HitResult.GetActor();
+			OverlappedActors.AddUnique(OverlappedActor);
+		}
+	}
 
-			if (Target == Actor)
-			{
-				bool bWasApplied = false;
+	// One spec per effect for the whole explosion, ApplyGameplayEffectSpecToSelf copies what it keeps.
+	TArray<FGameplayEffectSpec> DamageSpecs;
 
-				if (UAbilitySystemComponent* AbilityComponent = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Target))
-				{
-					FGameplayEffectContextHandle EffectContext = AbilityComponent->MakeEffectContext();
-					EffectContext.AddInstigator(DamageCauser, DamageCauser);
+	if (OverlappedActors.Num() > 0)
+	{
+		FGameplayEffectContextHandle EffectContext(UAbilitySystemGlobals::Get().AllocGameplayEffectContext());
+		EffectContext.AddInstigator(DamageCauser, DamageCauser);
 
-					for (auto Effect : DamageEffects)
-					{
-						FGameplayEffectSpecHandle SpecHandle = AbilityComponent->MakeOutgoingSpec(Effect, 1, EffectContext);
-						if (SpecHandle.IsValid())
-						{
-							UAbilitySystemBlueprintLibrary::AssignTagSetByCallerMagnitude(SpecHandle, FGameplayTag::RequestGameplayTag(TEXT("Attribute.Health")), -DamageAmount);
-
-							FActiveGameplayEffectHandle ActiveGEHandle = AbilityComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
-
-							if (ActiveGEHandle.WasSuccessfullyApplied())
-							{
-								bWasApplied = true;
-							}
-						}
-					}
-				}
+		DamageSpecs.Reserve(DamageEffects.Num());
 
-				if (bDebug)
-				{
-					DrawDebugLine(WorldContextObject->GetWorld(), Location, Actor->GetActorLocation(), bWasApplied ? FColor::Green : FColor::Red, false, 4.f, 0, 1);
-					DrawDebugSphere(WorldContextObject->GetWorld(), HitResult.Location, 16, 16, bWasApplied ? FColor::Green : FColor::Red, false, 4.f, 0, 1);
-					DrawDebugString(WorldContextObject->GetWorld(), HitResult.Location, *GetNameSafe(Target), nullptr, FColor::White, 0, false, 1.f);
-				}
-			}
-			else
+		for (auto Effect : DamageEffects)
+		{
+			if (Effect)
 			{
+				FGameplayEffectSpec& DamageSpec = DamageSpecs.Emplace_GetRef(GetDefault<UGameplayEffect>(Effect), EffectContext, 1.f);
+				DamageSpec.SetSetByCallerMagnitude(ActionGameTags::Attribute_Health, -DamageAmount);
+			}
+		}
+	}
 
-				if (bDebug)
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(ApplyRadialDamageOcclusion), true, DamageCauser);
+	TraceParams.bReturnPhysicalMaterial = true;
+
+	if (const AActor* ContextActor = Cast<AActor>(WorldContextObject))
+	{
+		TraceParams.AddIgnoredActor(ContextActor);
+	}
+
+	const ECollisionChannel TraceChannel = UEngineTypes::ConvertToCollisionChannel(TraceType);
+
+	for (AActor* Actor : OverlappedActors)
+	{
+		const FVector ActorLocation = Actor->GetActorLocation();
+
+		FHitResult HitResult;
+		ACTIONGAME_COUNT_TRACES(1);
+		const bool bHit = World->LineTraceSingleByChannel(HitResult, Location, ActorLocation, TraceChannel, TraceParams);
+
+		AActor* Target = HitResult.GetActor();
+		const bool bReachedActor = bHit && Target == Actor;
+
+		bool bWasApplied = false;
+
+		if (bReachedActor)
+		{
+			if (UAbilitySystemComponent* AbilityComponent = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Target))
+			{
+				for (const FGameplayEffectSpec& DamageSpec : DamageSpecs)
 				{
-					DrawDebugLine(WorldContextObject->GetWorld(), Location, Actor->GetActorLocation(), FColor::Red, false, 4.f, 0, 1);
-					DrawDebugSphere(WorldContextObject->GetWorld(), HitResult.Location, 16, 16,  FColor::Red, false, 4.f, 0, 1);
-					DrawDebugString(WorldContextObject->GetWorld(), HitResult.Location, *GetNameSafe(Target), nullptr, FColor::Red, 0, false, 1.f);
+					if (AbilityComponent->ApplyGameplayEffectSpecToSelf(DamageSpec).WasSuccessfullyApplied())
+					{
+						bWasApplied = true;
+					}
 				}
 			}
 		}
-		else
+
+		if (bDebug)
 		{
-			if (bDebug)
-			{
-				DrawDebugLine(WorldContextObject->GetWorld(), Location, Actor->GetActorLocation(), FColor::Red, false, 4.f, 0, 1);
-				DrawDebugSphere(WorldContextObject->GetWorld(), HitResult.Location, 16, 16, FColor::Red, false, 4.f, 0, 1);
-				DrawDebugString(WorldContextObject->GetWorld(), HitResult.Location, *GetNameSafe(HitResult.GetActor()), nullptr, FColor::Red, 0, false, 1.f);
-			}
+			const FColor Color = bWasApplied ? FColor::Green : FColor::Red;
+
+			DrawDebugLine(World, Location, ActorLocation, Color, false, 4.f, 0, 1);
+			DrawDebugSphere(World, HitResult.Location, 16, 16, Color, false, 4.f, 0, 1);
+			DrawDebugString(World, HitResult.Location, *GetNameSafe(Target), nullptr, bReachedActor ? FColor::White : FColor::Red, 0, false, 1.f);
 		}
 	}
 
 	if (bDebug)
 	{
-		DrawDebugSphere(WorldContextObject->GetWorld(), Location, Radius, 16, FColor::White, false, 4.f, 0, 1.f);
+		DrawDebugSphere(World, Location, Radius, 16, FColor::White, false, 4.f, 0, 1.f);
 	}
 }
 
-AProjectile* UActionGameStatics::LaunchProjectile(UObject* WorldContextObject, TSubclassOf<UProjectileStaticData> ProjectileDataClass, FTransform Transform, AActor* Owner, APawn* Instigator)
+int32 UActionGameStatics::LaunchProjectile(UObject* WorldContextObject, TSubclassOf<UProjectileStaticData> ProjectileDataClass, FTransform Transform, AActor* Owner, APawn* Instigator)
 {
 	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
 
 	if (World && World->IsNetMode(NM_DedicatedServer))
 	{
-		if (AProjectile* Projectile = World->SpawnActorDeferred<AProjectile>(AProjectile::StaticClass(), Transform, Owner, Instigator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn))
+		if (UProjectileSubsystem* ProjectileSubsystem = World->GetSubsystem<UProjectileSubsystem>())
 		{
-			Projectile->ProjectileDataClass = ProjectileDataClass;
-			Projectile->FinishSpawning(Transform);
-
-			return Projectile;
+			return ProjectileSubsystem->LaunchProjectile(ProjectileDataClass, Transform.GetLocation(), Transform.GetRotation().GetForwardVector(), Owner, Instigator);
 		}
 	}
 
-	return nullptr;
-}
\ No newline at end of file
+	return INDEX_NONE;
+}
@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("ActionGame"), STATGROUP_ActionGame, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ACTIONGAME_API, ActionGame);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces Issued"), STAT_ActionGameTracesIssued, STATGROUP_ActionGame, ACTIONGAME_API);
+
+// Scene queries issued by game code, shown per frame in "stat ActionGame" and as TracesIssued in the ActionGame CSV category.
+#define ACTIONGAME_COUNT_TRACES(Count) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(STAT_ActionGameTracesIssued, Count); \
+		CSV_CUSTOM_STAT(ActionGame, TracesIssued, Count, ECsvCustomStatOp::Accumulate); \
+	} while (0)
\ No newline at end of file
@@ -0,0 +1,14 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ActionGameTags.h"
+
+namespace ActionGameTags
+{
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Attribute_Health, "Attribute.Health", "SetByCaller magnitude for health changes");
+
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(State_Dead, "State.Dead", "Character is dead");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(State_Ragdoll, "State.Ragdoll", "Character is ragdolling");
+
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Movement_Enforced_Strafe, "Movement.Enforced.Strafe", "Character is forced to strafe");
+}
\ No newline at end of file
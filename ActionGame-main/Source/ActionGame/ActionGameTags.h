@@ -0,0 +1,17 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+
+// Tags used from native code, resolved once at startup instead of by name at the call site.
+namespace ActionGameTags
+{
+	ACTIONGAME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Attribute_Health);
+
+	ACTIONGAME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Dead);
+	ACTIONGAME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Ragdoll);
+
+	ACTIONGAME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Movement_Enforced_Strafe);
+}
\ No newline at end of file
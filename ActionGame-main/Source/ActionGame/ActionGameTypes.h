@@ -46,6 +46,40 @@ struct FCharacterAnimationData
 	class UAnimSequenceBase* CrouchIdleAnimationAsset = nullptr;
 };
 
+USTRUCT(BlueprintType)
+struct FWallRunData
+{
+	GENERATED_USTRUCT_BODY();
+
+	UPROPERTY(EditDefaultsOnly)
+	float WallRunSpeed = 700.f;
+
+	// Gravity scale while running on a wall.
+	UPROPERTY(EditDefaultsOnly)
+	float WallRunGravityScale = 0.2f;
+
+	// Gravity scale set when the wall run ends.
+	UPROPERTY(EditDefaultsOnly)
+	float EndGravityScale = 1.75f;
+
+	// Distance from the wall the character is snapped to when the wall run starts.
+	UPROPERTY(EditDefaultsOnly)
+	float WallOffset = 60.f;
+
+	// Added to the capsule radius to get the wall probe length.
+	UPROPERTY(EditDefaultsOnly)
+	float ProbeExtraLength = 30.f;
+
+	// Min dot between the wall normal and the character's side for the wall to be runnable.
+	UPROPERTY(EditDefaultsOnly)
+	float MinWallNormalDot = 0.3f;
+
+	// The wall is only probed again once the character moved this far along the wall since the last probe. Only the
+	// horizontal movement in the wall's plane counts, sliding up or down the wall doesn't trigger a probe.
+	UPROPERTY(EditDefaultsOnly)
+	float ReprobeDistance = 25.f;
+};
+
 UENUM(BlueprintType)
 enum class EFoot : uint8
 {
@@ -5,19 +5,17 @@
 #include "GameFramework/Character.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
-#include "ActionGameCharacter.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Animation/AnimInstance.h"
 #include "GameFramework/PhysicsVolume.h"
 #include "Kismet/GameplayStatics.h"
+#include "Subsystems/WallProbeSubsystem.h"
+#include "ActionGameTags.h"
+#include "ActionGameStats.h"
 
-static TAutoConsoleVariable<int32> CVarShowTraversal(
-	TEXT("ShowDebugTraversal"),
-	0,
-	TEXT("Draws debug info about traversal")
-	TEXT(" 0: off/n")
-	TEXT(" 1: on/n"),
-	ECVF_Cheat
-);
+DECLARE_CYCLE_STAT(TEXT("SweepAndStoreWallHits"), STAT_SweepAndStoreWallHits, STATGROUP_ActionGame);
+DECLARE_CYCLE_STAT(TEXT("PhysClimbing"), STAT_PhysClimbing, STATGROUP_ActionGame);
 
 UAG_CharacterMovementComponent::UAG_CharacterMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -33,21 +31,47 @@ void UAG_CharacterMovementComponent::BeginPlay()
 
 	if (UAbilitySystemComponent* AbilityComponent = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetOwner()))
 	{
-		AbilityComponent->RegisterGameplayTagEvent(FGameplayTag::RequestGameplayTag(TEXT("Movement.Enforced.Strafe"), EGameplayTagEventType::NewOrRemoved)).AddUObject(this, &UAG_CharacterMovementComponent::OnEnforcedStrafeTagChanged);
+		AbilityComponent->RegisterGameplayTagEvent(ActionGameTags::Movement_Enforced_Strafe, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &UAG_CharacterMovementComponent::OnEnforcedStrafeTagChanged);
 	}
 	AnimInstance = GetCharacterOwner()->GetMesh()->GetAnimInstance();
 	ClimbQueryParams.AddIgnoredActor(GetOwner());
+
+	if (UWallProbeSubsystem* WallProbeSubsystem = GetWorld()->GetSubsystem<UWallProbeSubsystem>())
+	{
+		WallProbeSubsystem->RegisterMovementComponent(this);
+	}
 }
 
-void UAG_CharacterMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType,
-	FActorComponentTickFunction* ThisTickFunction)
+void UAG_CharacterMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	SweepAndStoreWallHits();
+	if (UWallProbeSubsystem* WallProbeSubsystem = GetWorld()->GetSubsystem<UWallProbeSubsystem>())
+	{
+		WallProbeSubsystem->UnregisterMovementComponent(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+EWallProbePriority UAG_CharacterMovementComponent::GetWallProbePriority() const
+{
+	if (!CharacterOwner || CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
+	{
+		return EWallProbePriority::None;
+	}
+
+	if (bWantsToClimb || IsClimbing() || IsFalling())
+	{
+		return EWallProbePriority::Immediate;
+	}
+
+	return EWallProbePriority::Deferred;
 }
 
 void UAG_CharacterMovementComponent::SweepAndStoreWallHits()
 {
+	SCOPE_CYCLE_COUNTER(STAT_SweepAndStoreWallHits);
+	CSV_SCOPED_TIMING_STAT(ActionGame, SweepAndStoreWallHits);
+
 	const FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(CollisionCapsuleRadius, CollisionCapsuleHalfHeight);
 
 	const FVector StartOffset = UpdatedComponent->GetForwardVector() * 20;
@@ -56,11 +80,15 @@ void UAG_CharacterMovementComponent::SweepAndStoreWallHits()
 	const FVector Start = UpdatedComponent->GetComponentLocation() + StartOffset;
 	const FVector End = Start + UpdatedComponent->GetForwardVector();
 
-	TArray<FHitResult> Hits;
-	const bool HitWall = GetWorld()->SweepMultiByChannel(Hits, Start, End, FQuat::Identity,
+	ACTIONGAME_COUNT_TRACES(1);
+	// Sweep straight into the member buffer so its allocation is reused from frame to frame.
+	const bool HitWall = GetWorld()->SweepMultiByChannel(CurrentWallHits, Start, End, FQuat::Identity,
 		  ECC_WorldStatic, CollisionShape, ClimbQueryParams);
 
-	HitWall ? CurrentWallHits = Hits : CurrentWallHits.Reset();
+	if (!HitWall)
+	{
+		CurrentWallHits.Reset();
+	}
 }
 
 bool UAG_CharacterMovementComponent::CanStartClimbing()
@@ -104,6 +132,7 @@ bool UAG_CharacterMovementComponent::EyeHeightTrace(const float TraceDistance) c
 			(UpdatedComponent->GetUpVector() * GetCharacterOwner()->BaseEyeHeight);
 	const FVector End = Start + (UpdatedComponent->GetForwardVector() * TraceDistance);
 
+	ACTIONGAME_COUNT_TRACES(1);
 	return GetWorld()->LineTraceSingleByChannel(UpperEdgeHit, Start, End, ECC_WorldStatic, ClimbQueryParams);
 }
 
@@ -161,6 +190,9 @@ void UAG_CharacterMovementComponent::OnEnforcedStrafeTagChanged(const FGameplayT
 
 void UAG_CharacterMovementComponent::TryClimbing()
 {
+	// Grounded characters are only probed under the deferred budget, so refresh the hits on demand.
+	SweepAndStoreWallHits();
+
 	if (CanStartClimbing())
 	{
 		bWantsToClimb = true;
@@ -223,6 +255,9 @@ void UAG_CharacterMovementComponent::PhysCustom(float deltaTime, int32 Iteration
 
 void UAG_CharacterMovementComponent::PhysClimbing(float deltaTime, int32 Iterations)
 {
+	SCOPE_CYCLE_COUNTER(STAT_PhysClimbing);
+	CSV_SCOPED_TIMING_STAT(ActionGame, PhysClimbing);
+
 	if (deltaTime < MIN_TICK_TIME)
 	{
 		return;
@@ -232,14 +267,7 @@ void UAG_CharacterMovementComponent::PhysClimbing(float deltaTime, int32 Iterati
 
 	if (ShouldStopClimbing() || ClimbDownToFloor())
 	{
-		for (TObjectIterator<AActionGameCharacter> Itr; Itr; ++Itr)
-		{
-			if (Itr->IsA(AActionGameCharacter::StaticClass()))
-			{
-				AActionGameCharacter* actorClass = *Itr;
-				actorClass->OnEndClimb();
-			}
-		}
+		OnClimbEnded.Broadcast();
 		StopClimbing(deltaTime, Iterations);
 		return;
 	}
@@ -281,6 +309,7 @@ void UAG_CharacterMovementComponent::ComputeSurfaceInfo()
 		const FVector End = Start + (WallHit.ImpactPoint - Start).GetSafeNormal() * 120;
 
 		FHitResult AssistHit;
+		ACTIONGAME_COUNT_TRACES(1);
 		GetWorld()->SweepSingleByChannel(AssistHit, Start, End, FQuat::Identity,
 			ECC_WorldStatic, CollisionSphere, ClimbQueryParams);
 
@@ -393,6 +422,7 @@ bool UAG_CharacterMovementComponent::CheckFloor(FHitResult& FloorHit) const
 	const FVector Start = UpdatedComponent->GetComponentLocation();
 	const FVector End = Start + FVector::DownVector * FloorCheckDistance;
 
+	ACTIONGAME_COUNT_TRACES(1);
 	return GetWorld()->LineTraceSingleByChannel(FloorHit, Start, End, ECC_WorldStatic, ClimbQueryParams);
 }
 
@@ -432,6 +462,7 @@ bool UAG_CharacterMovementComponent::IsLocationWalkable(const FVector& CheckLoca
 	const FVector CheckEnd = CheckLocation + (FVector::DownVector * 250.f);
 
 	FHitResult LedgeHit;
+	ACTIONGAME_COUNT_TRACES(1);
 	const bool bHitLedgeGround = GetWorld()->LineTraceSingleByChannel(LedgeHit, CheckLocation, CheckEnd,
 																	  ECC_WorldStatic, ClimbQueryParams);
 
@@ -455,6 +486,7 @@ bool UAG_CharacterMovementComponent::CanMoveToLedgeClimbLocation() const
 	const FVector CapsuleStartCheck = CheckLocation - HorizontalOffset;
 	const UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
 
+	ACTIONGAME_COUNT_TRACES(1);
 	const bool bBlocked = GetWorld()->SweepSingleByChannel(CapsuleHit, CapsuleStartCheck,CheckLocation,
 		FQuat::Identity, ECC_WorldStatic, Capsule->GetCollisionShape(), ClimbQueryParams);
 
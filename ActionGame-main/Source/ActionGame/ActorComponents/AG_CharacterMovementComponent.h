@@ -11,6 +11,11 @@
 
 class UAbilitySystemComponent;
 class UGameplayAbility;
+class UWallProbeSubsystem;
+
+enum class EWallProbePriority : uint8;
+
+DECLARE_MULTICAST_DELEGATE(FOnClimbEndedDelegate);
 
 UENUM(BlueprintType)
 enum ECustomMovementMode
@@ -32,6 +37,8 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION(BlueprintPure)
 	EMovementDirectionType GetMovementDirectionType() const;
 
@@ -51,6 +58,9 @@ public:
 	UFUNCTION(BlueprintPure)
 	FVector GetClimbSurfaceNormal() const;
 
+	// Broadcast when the owning character leaves the climbing surface on its own (top, floor or lost wall).
+	FOnClimbEndedDelegate OnClimbEnded;
+
 protected:
 
 	UPROPERTY(EditDefaultsOnly)
@@ -62,8 +72,10 @@ protected:
 	void HandleMovementDirection();
 
 private:
-	
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	friend class UWallProbeSubsystem;
+
+	EWallProbePriority GetWallProbePriority() const;
 
 	void SweepAndStoreWallHits();
 
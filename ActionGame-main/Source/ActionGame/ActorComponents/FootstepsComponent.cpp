@@ -3,18 +3,12 @@
 
 #include "ActorComponents/FootstepsComponent.h"
 #include "PhysicalMaterials/AG_PhysicalMaterial.h"
-#include "Kismet/GameplayStatics.h"
+#include "Subsystems/FootstepSubsystem.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "ActionGameCharacter.h"
-#include "DrawDebugHelpers.h"
-
-static TAutoConsoleVariable<int32> CVarShowFootsteps(
-	TEXT("ShowDebugFootsteps"),
-	0,
-	TEXT("Draws debug info about footsteps")
-	TEXT("  0: off/n")
-	TEXT("  1: on/n"),
-	ECVF_Cheat);
+#include "ActionGameStats.h"
 
+DECLARE_CYCLE_STAT(TEXT("HandleFootstep"), STAT_HandleFootstep, STATGROUP_ActionGame);
 
 // Sets default values for this component's properties
 UFootstepsComponent::UFootstepsComponent()
@@ -38,60 +32,43 @@ void UFootstepsComponent::BeginPlay()
 
 void UFootstepsComponent::HandleFootstep(EFoot Foot)
 {
+	SCOPE_CYCLE_COUNTER(STAT_HandleFootstep);
+	CSV_SCOPED_TIMING_STAT(ActionGame, HandleFootstep);
+
 	if (AActionGameCharacter* Character = Cast<AActionGameCharacter>(GetOwner()))
 	{
-		const int32 DebugShowFootsteps = CVarShowFootsteps.GetValueOnAnyThread();
+		UFootstepSubsystem* FootstepSubsystem = GetWorld()->GetSubsystem<UFootstepSubsystem>();
+		USkeletalMeshComponent* Mesh = Character->GetMesh();
 
-		if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+		if (FootstepSubsystem && Mesh)
 		{
-			FHitResult HitResult;
 			const FVector SocketLocation = Mesh->GetSocketLocation(Foot == EFoot::Left ? LeftFootSocketName : RightFootSocketName);
 			const FVector Location = SocketLocation + FVector::UpVector * 20;
 
-			FCollisionQueryParams QueryParams;
-			QueryParams.bReturnPhysicalMaterial = true;
-			QueryParams.AddIgnoredActor(Character);
-
-			if (GetWorld()->LineTraceSingleByChannel(HitResult, Location, Location + FVector::UpVector * -50.f, ECollisionChannel::ECC_WorldStatic, QueryParams))
-			{
-				if (HitResult.bBlockingHit)
-				{
-					if (HitResult.PhysMaterial.Get())
-					{
-						UAG_PhysicalMaterial* PhysicalMaterial = Cast<UAG_PhysicalMaterial>(HitResult.PhysMaterial.Get());
-
-						if (PhysicalMaterial)
-						{
-							UGameplayStatics::PlaySoundAtLocation(this, PhysicalMaterial->FootstepSound, Location, 1.f);
-						}
-
-						if (DebugShowFootsteps > 0)
-						{
-							DrawDebugString(GetWorld(), Location, GetNameSafe(PhysicalMaterial), nullptr, FColor::White, 4.f);
-						}
-					}
-
-					if (DebugShowFootsteps > 0)
-					{
-						DrawDebugSphere(GetWorld(), Location, 16, 16, FColor::Red, false, 4.f);
-					}
-				}
-				else
-				{
-					if (DebugShowFootsteps > 0)
-					{
-						DrawDebugLine(GetWorld(), Location, Location + FVector::UpVector * -50.f, FColor::Red, false, 4, 0, 1);
-					}
-				}
-			}
-			else
-			{
-				if (DebugShowFootsteps > 0)
-				{
-					DrawDebugLine(GetWorld(), Location, Location + FVector::UpVector * -50.f, FColor::Red, false, 4, 0, 1);
-					DrawDebugSphere(GetWorld(), Location, 16, 16, FColor::Red, false, 4.f);
-				}
-			}
+			const UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+			UPrimitiveComponent* FloorComponent = CharacterMovement && CharacterMovement->CurrentFloor.bBlockingHit ? CharacterMovement->CurrentFloor.HitResult.GetComponent() : nullptr;
+
+			FootstepSubsystem->QueueFootstep(this, Foot, Location, FloorComponent);
 		}
 	}
+}
+
+const UAG_PhysicalMaterial* UFootstepsComponent::GetCachedFootSurface(EFoot Foot, const UPrimitiveComponent* InFloorComponent) const
+{
+	const int32 FootIndex = static_cast<int32>(Foot);
+
+	if (InFloorComponent && CachedFloorComponents[FootIndex].Get() == InFloorComponent)
+	{
+		return CachedPhysicalMaterials[FootIndex].Get();
+	}
+
+	return nullptr;
+}
+
+void UFootstepsComponent::SetCachedFootSurface(EFoot Foot, UPrimitiveComponent* InFloorComponent, const UAG_PhysicalMaterial* InPhysicalMaterial)
+{
+	const int32 FootIndex = static_cast<int32>(Foot);
+
+	CachedFloorComponents[FootIndex] = InFloorComponent;
+	CachedPhysicalMaterials[FootIndex] = InPhysicalMaterial;
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "ActionGameTypes.h"
 #include "FootstepsComponent.generated.h"
 
+class UAG_PhysicalMaterial;
+class UPrimitiveComponent;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class ACTIONGAME_API UFootstepsComponent : public UActorComponent
@@ -27,8 +29,17 @@ protected:
 	UPROPERTY(EditDefaultsOnly)
 	FName RightFootSocketName = TEXT("foot_r");
 
+	// Surface last traced under each foot, valid while the character stays on the same floor component.
+	TWeakObjectPtr<UPrimitiveComponent> CachedFloorComponents[2];
+
+	TWeakObjectPtr<const UAG_PhysicalMaterial> CachedPhysicalMaterials[2];
+
 public:	
 
 	void HandleFootstep(EFoot Foot);
+
+	const UAG_PhysicalMaterial* GetCachedFootSurface(EFoot Foot, const UPrimitiveComponent* InFloorComponent) const;
+
+	void SetCachedFootSurface(EFoot Foot, UPrimitiveComponent* InFloorComponent, const UAG_PhysicalMaterial* InPhysicalMaterial);
 		
 };
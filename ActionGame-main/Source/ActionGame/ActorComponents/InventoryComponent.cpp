@@ -11,33 +11,33 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "Actors/ItemActor.h"
+#include "Subsystems/ItemActorPoolSubsystem.h"
 
 #include "GameplayTagsManager.h"
 
-#include "Engine/ActorChannel.h"
-
 #include "AbilitySystemLog.h"
+#include "ActionGameStats.h"
+#include "ActionGameQueries.h"
+
+DECLARE_CYCLE_STAT(TEXT("AddItemInstance"), STAT_AddItemInstance, STATGROUP_ActionGame);
 
 FGameplayTag UInventoryComponent::EquipItemActorTag;
 FGameplayTag UInventoryComponent::DropItemTag;
 FGameplayTag UInventoryComponent::EquipNextTag;
 FGameplayTag UInventoryComponent::UnequipTag;
 
-static TAutoConsoleVariable<int32> CVarShowInventory(
-	TEXT("ShowDebugInventory"),
-	0,
-	TEXT("Draws debug info about inventory")
-	TEXT(" 0: off/n")
-	TEXT(" 1: on/n"),
-	ECVF_Cheat
-);
-
 // Sets default values for this component's properties
 UInventoryComponent::UInventoryComponent()
 {
+#if ACTIONGAME_DEBUG_DRAW
 	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+#else
+	PrimaryComponentTick.bCanEverTick = false;
+#endif
 	bWantsInitializeComponent = true;
 	SetIsReplicatedByDefault(true);
+	bReplicateUsingRegisteredSubObjectList = true;
 
 	static bool bHandledAddingTags = false;
 	if (!bHandledAddingTags)
@@ -73,6 +73,8 @@ void UInventoryComponent::InitializeComponent()
 {
 	Super::InitializeComponent();
 
+	InventoryList.SetOwnerComponent(this);
+
 	if (GetOwner()->HasAuthority())
 	{
 		for (auto ItemClass : DefaultItems)
@@ -91,6 +93,18 @@ void UInventoryComponent::InitializeComponent()
 	}
 }
 
+void UInventoryComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UpdateTickEnabled();
+}
+
+void UInventoryComponent::UpdateTickEnabled()
+{
+	SetComponentTickEnabled(ActionGameQueries::ShouldDrawDebug(CVarShowInventory));
+}
+
 void UInventoryComponent::AddItem(TSubclassOf<UItemStaticData> InItemStaticDataClass)
 {
 	if (GetOwner()->HasAuthority())
@@ -101,69 +115,54 @@ void UInventoryComponent::AddItem(TSubclassOf<UItemStaticData> InItemStaticDataC
 
 void UInventoryComponent::AddItemInstance(UInventoryItemInstance* InItemInstance)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AddItemInstance);
+	CSV_SCOPED_TIMING_STAT(ActionGame, AddItemInstance);
+
 	if (GetOwner()->HasAuthority())
 	{
-		TArray<UInventoryItemInstance*> Items = InventoryList.GetAllAvailableInstancesOfType(InItemInstance->ItemStaticDataClass);
+		const UItemStaticData* StaticData = InItemInstance->GetItemStaticData();
 
-		Algo::Sort(Items, [](UInventoryItemInstance* InA, UInventoryItemInstance* InB)
-		{
-			return InA->GetQuantity() < InB->GetQuantity();
-		}
-		);
-
-		const int32 MaxItemStackCount = InItemInstance->GetItemStaticData()->MaxStackCount;
+		const int32 MaxItemStackCount = FMath::Max(1, StaticData->MaxStackCount);
 
-		int32 ItemsLeft = InItemInstance->GetQuantity();
+		const int32 ItemsToAdd = InItemInstance->GetQuantity();
 
-		for (auto Item : Items)
-		{
-			const int32 EmptySlots = MaxItemStackCount - Item->GetQuantity();
+		int32 ItemsLeft = ItemsToAdd;
 
-			int32 SlotsToAdd = ItemsLeft;
+		// Top up the existing partial stacks first.
+		FInventoryInstanceArray PartialStacks;
+		InventoryList.GetAllAvailableInstancesOfType(InItemInstance->ItemStaticDataClass, PartialStacks);
 
-			if (ItemsLeft > EmptySlots)
+		for (UInventoryItemInstance* Item : PartialStacks)
+		{
+			if (ItemsLeft <= 0)
 			{
-				SlotsToAdd = EmptySlots;
+				break;
 			}
 
-			ItemsLeft -= SlotsToAdd;
+			const int32 SlotsToAdd = FMath::Min(ItemsLeft, MaxItemStackCount - Item->GetQuantity());
 
 			Item->AddItems(SlotsToAdd);
-			InItemInstance->AddItems(-SlotsToAdd);
-
-			for (FGameplayTag InvTag : Item->GetItemStaticData()->InventoryTags)
-			{
-				InventoryTags.AddTagCount(InvTag, SlotsToAdd);
-			}
-
-			if (ItemsLeft <= 0)
-			{
-				ItemsLeft = 0;
-
-				return;
-			}
+			ItemsLeft -= SlotsToAdd;
 		}
 
-		while (ItemsLeft > MaxItemStackCount)
+		// Whatever doesn't fit goes into full new stacks, the incoming instance keeps the remainder.
+		if (ItemsLeft > 0)
 		{
-			AddItem(InItemInstance->GetItemStaticData()->GetClass());
+			const int32 NumFullStacks = (ItemsLeft - 1) / MaxItemStackCount;
 
-			for (FGameplayTag InvTag : InItemInstance->GetItemStaticData()->InventoryTags)
-			{
-				InventoryTags.AddTagCount(InvTag, MaxItemStackCount);
-			}
+			InventoryList.AddFullStacks(InItemInstance->ItemStaticDataClass, NumFullStacks);
+
+			ItemsLeft -= NumFullStacks * MaxItemStackCount;
 
-			ItemsLeft -= MaxItemStackCount;
-			InItemInstance->AddItems(-MaxItemStackCount);
+			InventoryList.AddItem(InItemInstance);
 		}
 
-		InventoryList.AddItem(InItemInstance);
+		InItemInstance->AddItems(ItemsLeft - InItemInstance->GetQuantity());
 
-		for (FGameplayTag InvTag : InItemInstance->GetItemStaticData()->InventoryTags)
+		for (FGameplayTag InvTag : StaticData->InventoryTags)
 		{
-			InventoryTags.AddTagCount(InvTag, InItemInstance->GetQuantity());
+			InventoryTags.AddTagCount(InvTag, ItemsToAdd);
 		}
-
 	}
 }
 
@@ -194,7 +193,8 @@ void UInventoryComponent::RemoveItemWithInventoryTag(FGameplayTag Tag, int32 Cou
 	{
 		int32 CountLeft = Count;
 
-		TArray<UInventoryItemInstance*> Items = GetAllInstancesWithTag(Tag);
+		FInventoryInstanceArray Items;
+		GetAllInstancesWithTag(Tag, Items);
 
 		Algo::Sort(Items, [](UInventoryItemInstance* InA, UInventoryItemInstance* InB)
 		{
@@ -232,70 +232,58 @@ void UInventoryComponent::EquipItem(TSubclassOf<UItemStaticData> InItemStaticDat
 {
 	if (GetOwner()->HasAuthority())
 	{
-		for (auto Item : InventoryList.GetItemsRef())
+		if (UInventoryItemInstance* ItemInstance = InventoryList.FindFirstInstanceOfClass(InItemStaticDataClass))
 		{
-			if (Item.ItemInstance->ItemStaticDataClass == InItemStaticDataClass)
-			{
-				Item.ItemInstance->OnEquipped(GetOwner());
-
-				CurrentItem = Item.ItemInstance;
-
-				break;
-			}
+			EquipItemInstanceInternal(ItemInstance);
 		}
 	}
 }
 
 void UInventoryComponent::EquipItemInstance(UInventoryItemInstance* InItemInstance)
 {
-	if (GetOwner()->HasAuthority())
+	if (GetOwner()->HasAuthority() && InventoryList.ContainsInstance(InItemInstance))
 	{
-		for (auto Item : InventoryList.GetItemsRef())
-		{
-			if (Item.ItemInstance == InItemInstance)
-			{
-				Item.ItemInstance->OnEquipped(GetOwner());
-				CurrentItem = Item.ItemInstance;
-				break;
-			}
-		}
+		EquipItemInstanceInternal(InItemInstance);
 	}
 }
 
-void UInventoryComponent::EquipNext()
+void UInventoryComponent::EquipItemInstanceInternal(UInventoryItemInstance* InItemInstance)
 {
-	TArray<FInventoryListItem>& Items = InventoryList.GetItemsRef();
+	InItemInstance->OnEquipped(GetOwner());
+	CurrentItem = InItemInstance;
+	UpdateReplicatedItemInstanceCondition(CurrentItem);
+
+	OnEquippedItemChanged.Broadcast();
+}
 
-	const bool bNoItems = Items.Num() == 0;
-	const bool bOneAndEquipped = Items.Num() == 1 && CurrentItem;
+void UInventoryComponent::EquipNext()
+{
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
 
-	if(bNoItems || bOneAndEquipped) return;
+	const TArray<UInventoryItemInstance*>& Equippables = InventoryList.GetEquippableInstances();
 
-	UInventoryItemInstance* TargetItem = CurrentItem;
+	const int32 CurrentIndex = GetCurrentEquippableIndex();
+	const int32 TargetIndex = CurrentIndex == INDEX_NONE ? 0 : (CurrentIndex + 1) % FMath::Max(1, Equippables.Num());
 
-	for (auto Item : Items)
+	if (!Equippables.IsValidIndex(TargetIndex) || TargetIndex == CurrentIndex)
 	{
-		if (Item.ItemInstance->GetItemStaticData()->bCanBeEquipped)
-		{
-			if (Item.ItemInstance != CurrentItem)
-			{
-				TargetItem = Item.ItemInstance;
-				break;
-			}
-		}
+		return;
 	}
 
+	UInventoryItemInstance* TargetItem = Equippables[TargetIndex];
+
 	if (CurrentItem)
 	{
-		if (TargetItem == CurrentItem)
-		{
-			return;
-		}
-
 		UnequipItem();
 	}
 
-	EquipItemInstance(TargetItem);
+	// Taken from the inventory's own equippable list, no need to look it up again.
+	EquipItemInstanceInternal(TargetItem);
+
+	CurrentEquippableIndex = TargetIndex;
 }
 
 void UInventoryComponent::UnequipItem()
@@ -304,8 +292,14 @@ void UInventoryComponent::UnequipItem()
 	{
 		if (IsValid(CurrentItem))
 		{
+			UInventoryItemInstance* UnequippedItem = CurrentItem;
+
 			CurrentItem->OnUnequipped(GetOwner());
 			CurrentItem = nullptr;
+
+			UpdateReplicatedItemInstanceCondition(UnequippedItem);
+
+			OnEquippedItemChanged.Broadcast();
 		}
 	}
 }
@@ -319,15 +313,39 @@ void UInventoryComponent::DropItem()
 			CurrentItem->OnDropped(GetOwner());
 			RemoveItem(CurrentItem->ItemStaticDataClass);
 			CurrentItem = nullptr;
+
+			OnEquippedItemChanged.Broadcast();
 		}
 	}
 }
 
+void UInventoryComponent::OnRep_CurrentItem()
+{
+	OnEquippedItemChanged.Broadcast();
+}
+
 UInventoryItemInstance* UInventoryComponent::GetEquippedItem() const
 {
 	return CurrentItem;
 }
 
+int32 UInventoryComponent::GetCurrentEquippableIndex() const
+{
+	if (!CurrentItem)
+	{
+		return INDEX_NONE;
+	}
+
+	const TArray<UInventoryItemInstance*>& Equippables = InventoryList.GetEquippableInstances();
+
+	if (!Equippables.IsValidIndex(CurrentEquippableIndex) || Equippables[CurrentEquippableIndex] != CurrentItem)
+	{
+		CurrentEquippableIndex = Equippables.IndexOfByKey(CurrentItem);
+	}
+
+	return CurrentEquippableIndex;
+}
+
 void UInventoryComponent::GameplayEventCallback(const FGameplayEventData* Payload)
 {
 	ENetRole NetRole = GetOwnerRole();
@@ -342,13 +360,9 @@ void UInventoryComponent::GameplayEventCallback(const FGameplayEventData* Payloa
 	}
 }
 
-TArray<UInventoryItemInstance*> UInventoryComponent::GetAllInstancesWithTag(FGameplayTag Tag)
+void UInventoryComponent::GetAllInstancesWithTag(FGameplayTag Tag, FInventoryInstanceArray& OutInstances) const
 {
-	TArray<UInventoryItemInstance*> OutInstances;
-
-	OutInstances = InventoryList.GetAllInstancesWithTag(Tag);
-
-	return OutInstances;
+	InventoryList.GetAllInstancesWithTag(Tag, OutInstances);
 }
 
 void UInventoryComponent::HandleGameplayEventInternal(FGameplayEventData Payload)
@@ -367,7 +381,19 @@ void UInventoryComponent::HandleGameplayEventInternal(FGameplayEventData Payload
 
 				if (Payload.Instigator)
 				{
-					const_cast<AActor*>(Payload.Instigator.Get())->Destroy();
+					AActor* PickedUpActor = const_cast<AActor*>(Payload.Instigator.Get());
+
+					AItemActor* PickedUpItemActor = Cast<AItemActor>(PickedUpActor);
+					UItemActorPoolSubsystem* ItemActorPool = GetWorld()->GetSubsystem<UItemActorPoolSubsystem>();
+
+					if (PickedUpItemActor && ItemActorPool)
+					{
+						ItemActorPool->ReleaseItemActor(PickedUpItemActor);
+					}
+					else
+					{
+						PickedUpActor->Destroy();
+					}
 				}
 			}
 		}
@@ -391,21 +417,34 @@ void UInventoryComponent::ServerHandleGameplayEvent_Implementation(FGameplayEven
 	HandleGameplayEventInternal(Payload);
 }
 
-bool UInventoryComponent::ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags)
+void UInventoryComponent::AddReplicatedItemInstance(UInventoryItemInstance* InItemInstance)
 {
-	bool WroteSomething = Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
+	if (IsValid(InItemInstance) && GetOwner()->HasAuthority())
+	{
+		AddReplicatedSubObject(InItemInstance, GetItemInstanceReplicationCondition(InItemInstance));
+	}
+}
 
-	for (FInventoryListItem& Item : InventoryList.GetItemsRef())
+void UInventoryComponent::RemoveReplicatedItemInstance(UInventoryItemInstance* InItemInstance)
+{
+	if (InItemInstance && GetOwner()->HasAuthority())
 	{
-		UInventoryItemInstance* ItemInstance = Item.ItemInstance;
+		RemoveReplicatedSubObject(InItemInstance);
+	}
+}
 
-		if (IsValid(ItemInstance))
-		{
-			WroteSomething |= Channel->ReplicateSubobject(ItemInstance, *Bunch, *RepFlags);
-		}
+void UInventoryComponent::UpdateReplicatedItemInstanceCondition(UInventoryItemInstance* InItemInstance)
+{
+	if (IsValid(InItemInstance) && IsReplicatedSubObjectRegistered(InItemInstance))
+	{
+		RemoveReplicatedSubObject(InItemInstance);
+		AddReplicatedSubObject(InItemInstance, GetItemInstanceReplicationCondition(InItemInstance));
 	}
+}
 
-	return WroteSomething;
+ELifetimeCondition UInventoryComponent::GetItemInstanceReplicationCondition(const UInventoryItemInstance* InItemInstance) const
+{
+	return InItemInstance == CurrentItem ? COND_None : COND_OwnerOnly;
 }
 
 // Called every frame
@@ -413,7 +452,8 @@ void UInventoryComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	const bool bShowDebug = CVarShowInventory.GetValueOnGameThread() != 0;
+#if ACTIONGAME_DEBUG_DRAW
+	const bool bShowDebug = ActionGameQueries::ShouldDrawDebug(CVarShowInventory);
 	if (bShowDebug)
 	{
 		for (FInventoryListItem& Item : InventoryList.GetItemsRef())
@@ -429,18 +469,20 @@ void UInventoryComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 
 		const TArray<FFastArrayTagCounterRecord>& InventoryTagArray = InventoryTags.GetTagArray();
 
-		for (auto TagRecord : InventoryTagArray)
+		for (const FFastArrayTagCounterRecord& TagRecord : InventoryTagArray)
 		{
 			GEngine->AddOnScreenDebugMessage(-1, 0, FColor::Purple, FString::Printf(TEXT("Tag: %s %d"), *TagRecord.Tag.ToString(), TagRecord.Count));
 		}
 	}
+#endif
 }
 
 void UInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UInventoryComponent, InventoryList);
+	// Only the owner can resolve the non equipped instances, other connections get the equipped one through CurrentItem.
+	DOREPLIFETIME_CONDITION(UInventoryComponent, InventoryList, COND_OwnerOnly);
 	DOREPLIFETIME(UInventoryComponent, CurrentItem);
-	DOREPLIFETIME(UInventoryComponent, InventoryTags);
+	DOREPLIFETIME_CONDITION(UInventoryComponent, InventoryTags, COND_OwnerOnly);
 }
\ No newline at end of file
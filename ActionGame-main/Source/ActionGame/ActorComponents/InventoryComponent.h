@@ -9,6 +9,7 @@
 #include "FastArrayTagCounter.h"
 #include "InventoryComponent.generated.h"
 
+DECLARE_MULTICAST_DELEGATE(FOnEquippedItemChangedDelegate);
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class ACTIONGAME_API UInventoryComponent : public UActorComponent
@@ -21,7 +22,10 @@ public:
 
 	virtual void InitializeComponent() override;
 
-	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
+	virtual void BeginPlay() override;
+
+	// The component only ticks to draw the ShowDebugInventory overlay.
+	void UpdateTickEnabled();
 
 	UFUNCTION(BlueprintCallable)
 	void AddItem(TSubclassOf<UItemStaticData> InItemStaticDataClass);
@@ -56,6 +60,9 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	UInventoryItemInstance* GetEquippedItem() const;
 
+	// Broadcast on the server when the equipped item changes and on clients when it replicates.
+	FOnEquippedItemChangedDelegate OnEquippedItemChanged;
+
 	virtual void GameplayEventCallback(const FGameplayEventData* Payload);
 
 	static FGameplayTag EquipItemActorTag;
@@ -80,13 +87,36 @@ protected:
 	UPROPERTY(EditDefaultsOnly)
 	TArray<TSubclassOf<UItemStaticData>> DefaultItems;
 
-	UPROPERTY(Replicated)
+	UPROPERTY(ReplicatedUsing = OnRep_CurrentItem)
 	UInventoryItemInstance* CurrentItem = nullptr;
 
+	UFUNCTION()
+	void OnRep_CurrentItem();
+
+	// Equips an instance already known to be in the inventory.
+	void EquipItemInstanceInternal(UInventoryItemInstance* InItemInstance);
+
+	// Position of CurrentItem in the inventory's equippable list, rechecked only after the list has changed.
+	int32 GetCurrentEquippableIndex() const;
+
+	mutable int32 CurrentEquippableIndex = INDEX_NONE;
+
 	UPROPERTY(Replicated)
 	FFastArrayTagCounter InventoryTags;
 
-	TArray<UInventoryItemInstance*> GetAllInstancesWithTag(FGameplayTag Tag);
+	void GetAllInstancesWithTag(FGameplayTag Tag, FInventoryInstanceArray& OutInstances) const;
+
+	friend struct FInventoryList;
+
+	// Item instances replicate through the registered subobject list. The equipped item goes to everyone,
+	// the rest of the inventory only to the owning client.
+	void AddReplicatedItemInstance(UInventoryItemInstance* InItemInstance);
+
+	void RemoveReplicatedItemInstance(UInventoryItemInstance* InItemInstance);
+
+	void UpdateReplicatedItemInstanceCondition(UInventoryItemInstance* InItemInstance);
+
+	ELifetimeCondition GetItemInstanceReplicationCondition(const UInventoryItemInstance* InItemInstance) const;
 
 	void HandleGameplayEventInternal(FGameplayEventData Payload);
 
@@ -94,6 +124,6 @@ protected:
 	void ServerHandleGameplayEvent(FGameplayEventData Payload);
 
 public:	
-	// Called every frame
+	// Only ticks while ShowDebugInventory is on, see UpdateTickEnabled.
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 };
@@ -3,36 +3,68 @@
 
 #include "Actors/ItemActor.h"
 #include "Net/UnrealNetwork.h"
-#include "Engine/ActorChannel.h"
 #include "AbilitySystemBlueprintLibrary.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "Components/SphereComponent.h"
 #include "ActorComponents/InventoryComponent.h"
 #include "Inventory/InventoryItemInstance.h"
+#include "ActionGameStats.h"
+#include "ActionGameQueries.h"
+#include "GameFramework/Pawn.h"
+#include "TimerManager.h"
+
+static TAutoConsoleVariable<float> CVarItemActorDormancyDelay(
+	TEXT("ItemActorDormancyDelay"),
+	2.f,
+	TEXT("Seconds a dropped or placed item waits before going net dormant"),
+	ECVF_Default);
 
 // Sets default values
 AItemActor::AItemActor()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 	bReplicates = true;
+	bReplicateUsingRegisteredSubObjectList = true;
 	SetReplicateMovement(true);
 
 	SphereComponent = CreateDefaultSubobject<USphereComponent>(TEXT("USphereComponent"));
 	SphereComponent->SetupAttachment(RootComponent);
+
+	// Only pawns can pick items up, leave projectiles, other items and ragdoll bodies out of the overlap query.
+	SphereComponent->SetCollisionObjectType(ECC_WorldDynamic);
+	SphereComponent->SetCollisionResponseToAllChannels(ECR_Ignore);
+	SphereComponent->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
 	SphereComponent->OnComponentBeginOverlap.AddDynamic(this, &AItemActor::OnSphereOverlap);
 }
 
 void AItemActor::Init(UInventoryItemInstance* InInstance)
 {
-	ItemInstance = InInstance;
+	SetItemInstance(InInstance);
 
 	InitInternal();
 }
 
+void AItemActor::SetItemInstance(UInventoryItemInstance* InInstance)
+{
+	if (HasAuthority() && ItemInstance != InInstance)
+	{
+		if (ItemInstance)
+		{
+			RemoveReplicatedSubObject(ItemInstance);
+		}
+
+		if (InInstance)
+		{
+			AddReplicatedSubObject(InInstance);
+		}
+	}
+
+	ItemInstance = InInstance;
+}
+
 void AItemActor::OnRep_ItemInstance(UInventoryItemInstance* OldItemInstance)
 {
-	if (IsValid(ItemInstance) && !IsValid(OldItemInstance))
+	// Pooled actors get re-initialized with a different instance, InitInternal reuses the existing components.
+	if (IsValid(ItemInstance) && ItemInstance != OldItemInstance)
 	{
 		InitInternal();
 	}
@@ -40,6 +72,9 @@ void AItemActor::OnRep_ItemInstance(UInventoryItemInstance* OldItemInstance)
 
 void AItemActor::OnEquipped()
 {
+	GetWorldTimerManager().ClearTimer(DormancyTimerHandle);
+	SetNetDormancy(DORM_Awake);
+
 	ItemState = EItemState::Equipped;
 
 	SphereComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -72,17 +107,17 @@ void AItemActor::OnDropped()
 		const FVector TraceStart = Location + Forward * droppItemDist;
 		const FVector TraceEnd = TraceStart - FVector::UpVector * droppItemTraceDist;
 
-		TArray<AActor*> ActorsToIgnore = { GetOwner() };
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ItemDropTrace), true, ActorOwner);
+		QueryParams.AddIgnoredActor(this);
 
 		FHitResult TraceHit;
 
-		static const auto CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ShowDebugInventory"));
-		const bool bShowInventory = CVar->GetInt() > 0;
+		const bool bShowInventory = ActionGameQueries::ShouldDrawDebug(CVarShowInventory);
 
 		FVector TargetLocation = TraceEnd;
 
-		EDrawDebugTrace::Type DebugDrawType = bShowInventory ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None;
-		if (UKismetSystemLibrary::LineTraceSingleByProfile(this, TraceStart, TraceEnd, TEXT("WorldStatic"), true, ActorsToIgnore, DebugDrawType, TraceHit, true))
+		ACTIONGAME_COUNT_TRACES(1);
+		if (ActionGameQueries::LineTraceSingleByProfile(GetWorld(), TraceHit, TraceStart, TraceEnd, ActionGameQueries::ItemDropProfileName, QueryParams, bShowInventory))
 		{
 			if (TraceHit.bBlockingHit)
 			{
@@ -95,6 +130,43 @@ void AItemActor::OnDropped()
 		SphereComponent->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 		SphereComponent->SetGenerateOverlapEvents(true);
 	}
+
+	ScheduleDormancy();
+}
+
+void AItemActor::OnReturnedToPool()
+{
+	GetWorldTimerManager().ClearTimer(DormancyTimerHandle);
+	PickupCandidates.Reset();
+
+	// The item may be lying dormant, make sure clients still see it go away.
+	FlushNetDormancy();
+
+	ItemState = EItemState::None;
+
+	// Picked up items keep their instance pointing at this actor, clear it before the actor can be reused.
+	if (ItemInstance)
+	{
+		ItemInstance->OnItemActorReleased(this);
+	}
+
+	SetItemInstance(nullptr);
+
+	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	SetOwner(nullptr);
+	SetActorHiddenInGame(true);
+
+	SphereComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SphereComponent->SetGenerateOverlapEvents(false);
+
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AItemActor::OnTakenFromPool()
+{
+	SetNetDormancy(DORM_Awake);
+
+	SetActorHiddenInGame(false);
 }
 
 void AItemActor::OnRep_ItemState()
@@ -114,24 +186,71 @@ void AItemActor::OnRep_ItemState()
 
 void AItemActor::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
-	if (HasAuthority())
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	// A character overlaps with both its capsule and its mesh, only count the capsule.
+	APawn* Pawn = Cast<APawn>(OtherActor);
+	if (!Pawn || OtherComp != Pawn->GetRootComponent())
+	{
+		return;
+	}
+
+	if (PickupCandidates.Num() == 0)
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &AItemActor::ProcessPickupCandidates);
+	}
+
+	PickupCandidates.AddUnique(Pawn);
+}
+
+void AItemActor::ProcessPickupCandidates()
+{
+	const FVector Location = GetActorLocation();
+
+	// Picking the item up hands the actor back to the pool, which resets the candidates.
+	TArray<TWeakObjectPtr<APawn>> Candidates = MoveTemp(PickupCandidates);
+	PickupCandidates.Reset();
+
+	Candidates.RemoveAll([](const TWeakObjectPtr<APawn>& Candidate) { return !Candidate.IsValid(); });
+	Candidates.Sort([&Location](const TWeakObjectPtr<APawn>& A, const TWeakObjectPtr<APawn>& B)
 	{
+		return FVector::DistSquared(A->GetActorLocation(), Location) < FVector::DistSquared(B->GetActorLocation(), Location);
+	});
+
+	// Pawns that reached the item on the same frame used to all receive it, now only the closest one that takes it does.
+	for (const TWeakObjectPtr<APawn>& Candidate : Candidates)
+	{
+		if (IsActorBeingDestroyed() || !IsValid(ItemInstance) || ItemState == EItemState::Equipped)
+		{
+			break;
+		}
+
 		FGameplayEventData EventPayload;
 		EventPayload.Instigator = this;
 		EventPayload.OptionalObject = ItemInstance;
 		EventPayload.EventTag = UInventoryComponent::EquipItemActorTag;
 
-		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(OtherActor, UInventoryComponent::EquipItemActorTag, EventPayload);
+		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(Candidate.Get(), UInventoryComponent::EquipItemActorTag, EventPayload);
 	}
 }
 
-bool AItemActor::ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags)
+void AItemActor::ScheduleDormancy()
 {
-	bool WroteSomething = Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
+	if (HasAuthority())
+	{
+		GetWorldTimerManager().SetTimer(DormancyTimerHandle, this, &AItemActor::GoDormant, FMath::Max(CVarItemActorDormancyDelay.GetValueOnGameThread(), 0.01f), false);
+	}
+}
 
-	WroteSomething |= Channel->ReplicateSubobject(ItemInstance, *Bunch, *RepFlags);
-		
-	return WroteSomething;
+void AItemActor::GoDormant()
+{
+	if (ItemState != EItemState::Equipped)
+	{
+		SetNetDormancy(DORM_DormantAll);
+	}
 }
 
 // Called when the game starts or when spawned
@@ -143,13 +262,16 @@ void AItemActor::BeginPlay()
 	{
 		if (!IsValid(ItemInstance) && IsValid(ItemStaticDataClass))
 		{
-			ItemInstance = NewObject<UInventoryItemInstance>();
-			ItemInstance->Init(ItemStaticDataClass, Quantity);
+			UInventoryItemInstance* NewItemInstance = NewObject<UInventoryItemInstance>();
+			NewItemInstance->Init(ItemStaticDataClass, Quantity);
+			SetItemInstance(NewItemInstance);
 
 			SphereComponent->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 			SphereComponent->SetGenerateOverlapEvents(true);
 
 			InitInternal();
+
+			ScheduleDormancy();
 		}
 	}
 }
@@ -159,13 +281,6 @@ void AItemActor::InitInternal()
 	
 }
 
-// Called every frame
-void AItemActor::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-}
-
 void AItemActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -26,7 +26,10 @@ public:
 	virtual void OnUnequipped();
 	virtual void OnDropped();
 
-	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
+	// Called by UItemActorPoolSubsystem when the actor is parked and when it's handed out again.
+	virtual void OnReturnedToPool();
+	virtual void OnTakenFromPool();
+
 
 	void Init(UInventoryItemInstance* InInstance);
 
@@ -40,6 +43,9 @@ protected:
 	UFUNCTION()
 	void OnRep_ItemInstance(UInventoryItemInstance* OldItemInstance);
 
+	// Swaps the instance and keeps the replicated subobject list in sync on the server.
+	void SetItemInstance(UInventoryItemInstance* InInstance);
+
 	UPROPERTY(ReplicatedUsing = OnRep_ItemState)
 	TEnumAsByte<EItemState> ItemState = EItemState::None;
 
@@ -52,6 +58,18 @@ protected:
 	UFUNCTION()
 	void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
+	// Server only. Pawns that overlapped the pickup sphere this frame, the closest one gets the item next tick.
+	TArray<TWeakObjectPtr<APawn>> PickupCandidates;
+
+	void ProcessPickupCandidates();
+
+	// Lying items don't change until picked up, stop considering them for replication once they had time to go out.
+	void ScheduleDormancy();
+
+	void GoDormant();
+
+	FTimerHandle DormancyTimerHandle;
+
 	UPROPERTY(EditAnywhere)
 	TSubclassOf<UItemStaticData> ItemStaticDataClass;
 
@@ -59,9 +77,4 @@ protected:
 	int32 Quantity = 1;
 
 	virtual void InitInternal();
-
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 };
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Actors/ProjectileReplicator.h"
+
+#include "Subsystems/ProjectileSubsystem.h"
+#include "Net/UnrealNetwork.h"
+
+void FProjectileSpawnList::AddSpawn(const FProjectileSpawnItem& InSpawnItem)
+{
+	FProjectileSpawnItem& Item = Items.Add_GetRef(InSpawnItem);
+	MarkItemDirty(Item);
+}
+
+void FProjectileSpawnList::RemoveSpawn(int32 InProjectileId)
+{
+	const int32 Index = Items.IndexOfByPredicate([InProjectileId](const FProjectileSpawnItem& Item)
+	{
+		return Item.ProjectileId == InProjectileId;
+	});
+
+	if (Index != INDEX_NONE)
+	{
+		Items.RemoveAtSwap(Index);
+		MarkArrayDirty();
+	}
+}
+
+void FProjectileSpawnList::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
+{
+	UWorld* World = OwnerActor ? OwnerActor->GetWorld() : nullptr;
+
+	if (UProjectileSubsystem* ProjectileSubsystem = World ? World->GetSubsystem<UProjectileSubsystem>() : nullptr)
+	{
+		for (int32 Index : RemovedIndices)
+		{
+			ProjectileSubsystem->StopSimulatedProjectile(Items[Index].ProjectileId);
+		}
+	}
+}
+
+void FProjectileSpawnList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
+{
+	UWorld* World = OwnerActor ? OwnerActor->GetWorld() : nullptr;
+
+	if (UProjectileSubsystem* ProjectileSubsystem = World ? World->GetSubsystem<UProjectileSubsystem>() : nullptr)
+	{
+		for (int32 Index : AddedIndices)
+		{
+			ProjectileSubsystem->AddSimulatedProjectile(Items[Index]);
+		}
+	}
+}
+
+AProjectileReplicator::AProjectileReplicator()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	bReplicates = true;
+	bAlwaysRelevant = true;
+
+	SetRootComponent(CreateDefaultSubobject<USceneComponent>(TEXT("Root")));
+
+	SpawnList.OwnerActor = this;
+}
+
+void AProjectileReplicator::AddSpawn(const FProjectileSpawnItem& InSpawnItem)
+{
+	SpawnList.AddSpawn(InSpawnItem);
+}
+
+void AProjectileReplicator::RemoveSpawn(int32 InProjectileId)
+{
+	SpawnList.RemoveSpawn(InProjectileId);
+}
+
+void AProjectileReplicator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UProjectileSubsystem>())
+	{
+		ProjectileSubsystem->SetReplicator(this);
+	}
+}
+
+void AProjectileReplicator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UProjectileSubsystem>();
+
+	if (ProjectileSubsystem && ProjectileSubsystem->GetReplicator() == this)
+	{
+		ProjectileSubsystem->SetReplicator(nullptr);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AProjectileReplicator::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AProjectileReplicator, SpawnList);
+}
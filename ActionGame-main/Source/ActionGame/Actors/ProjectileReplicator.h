@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "ActionGameTypes.h"
+#include "ProjectileReplicator.generated.h"
+
+class AProjectileReplicator;
+
+// Everything a client needs to simulate a projectile on its own, sent once per projectile.
+USTRUCT()
+struct FProjectileSpawnItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY()
+	int32 ProjectileId = INDEX_NONE;
+
+	UPROPERTY()
+	TSubclassOf<UProjectileStaticData> ProjectileDataClass;
+
+	UPROPERTY()
+	FVector_NetQuantize Origin = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantize Velocity = FVector::ZeroVector;
+
+	UPROPERTY()
+	float ServerSpawnTime = 0.f;
+
+	UPROPERTY()
+	APawn* Instigator = nullptr;
+};
+
+USTRUCT()
+struct FProjectileSpawnList : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+public:
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FProjectileSpawnItem, FProjectileSpawnList>(Items, DeltaParams, *this);
+	}
+
+	void AddSpawn(const FProjectileSpawnItem& InSpawnItem);
+
+	void RemoveSpawn(int32 InProjectileId);
+
+	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
+	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
+
+	AProjectileReplicator* OwnerActor = nullptr;
+
+protected:
+
+	UPROPERTY()
+	TArray<FProjectileSpawnItem> Items;
+};
+
+template<>
+struct TStructOpsTypeTraits<FProjectileSpawnList> : public TStructOpsTypeTraitsBase2<FProjectileSpawnList>
+{
+	enum {WithNetDeltaSerializer = true};
+};
+
+/**
+ * Single always relevant actor per world that replicates the spawn parameters of the projectiles simulated by
+ * UProjectileSubsystem, and hosts the instanced meshes that draw them on clients.
+ */
+UCLASS(NotBlueprintable)
+class ACTIONGAME_API AProjectileReplicator : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	AProjectileReplicator();
+
+	void AddSpawn(const FProjectileSpawnItem& InSpawnItem);
+
+	void RemoveSpawn(int32 InProjectileId);
+
+protected:
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(Replicated)
+	FProjectileSpawnList SpawnList;
+};
@@ -13,104 +13,122 @@
 #include "ActorComponents/InventoryComponent.h"
 #include "Inventory/InventoryItemInstance.h"
 
-const UItemStaticData* UAG_AnimInstance::GetEquippedItemData() const
+void UAG_AnimInstance::NativeInitializeAnimation()
 {
-	AActionGameCharacter* ActionGameCharacter = Cast<AActionGameCharacter>(GetOwningActor());
-	UInventoryComponent* InventoryComponent = ActionGameCharacter ? ActionGameCharacter->GetInventoryComponent() : nullptr;
-	UInventoryItemInstance* ItemInstance = InventoryComponent ? InventoryComponent->GetEquippedItem() : nullptr;
+	Super::NativeInitializeAnimation();
 
-	return ItemInstance ? ItemInstance->GetItemStaticData() : nullptr;
-
-}
-
-UBlendSpace* UAG_AnimInstance::GetLocomotionBlendspace() const
-{
 	if (AActionGameCharacter* ActionGameCharacter = Cast<AActionGameCharacter>(GetOwningActor()))
 	{
-		if (const UItemStaticData* ItemData = GetEquippedItemData())
-		{
-			if (ItemData->CharacterAnimationData.MovementBlendspace)
-			{
-				return ItemData->CharacterAnimationData.MovementBlendspace;
-			}
-		}
-
-		FCharacterData Data = ActionGameCharacter->GetCharacterData();
+		ActionGameCharacter->OnCharacterDataChanged.RemoveAll(this);
+		ActionGameCharacter->OnCharacterDataChanged.AddUObject(this, &UAG_AnimInstance::MarkAnimationDataDirty);
+		BoundCharacter = ActionGameCharacter;
 
-		if (Data.CharacterAnimDataAsset)
+		if (UInventoryComponent* InventoryComponent = ActionGameCharacter->GetInventoryComponent())
 		{
-			return Data.CharacterAnimDataAsset->CharacterAnimationData.MovementBlendspace;
+			InventoryComponent->OnEquippedItemChanged.RemoveAll(this);
+			InventoryComponent->OnEquippedItemChanged.AddUObject(this, &UAG_AnimInstance::MarkAnimationDataDirty);
+			BoundInventoryComponent = InventoryComponent;
 		}
 	}
 
-	return DefaultCharacterAnimDataAsset ? DefaultCharacterAnimDataAsset->CharacterAnimationData.MovementBlendspace : nullptr;
+	MarkAnimationDataDirty();
 }
 
-UAnimSequenceBase* UAG_AnimInstance::GetIdleAnimation() const
+void UAG_AnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
-	if (AActionGameCharacter* ActionGameCharacter = Cast<AActionGameCharacter>(GetOwningActor()))
+	Super::NativeUpdateAnimation(DeltaSeconds);
+
+	if (bAnimationDataDirty)
 	{
-		if (const UItemStaticData* ItemData = GetEquippedItemData())
-		{
-			if (ItemData->CharacterAnimationData.IdleAnimationAsset)
-			{
-				return ItemData->CharacterAnimationData.IdleAnimationAsset;
-			}
-		}
+		ResolveAnimationData();
+	}
+}
 
-		FCharacterData Data = ActionGameCharacter->GetCharacterData();
+void UAG_AnimInstance::NativeUninitializeAnimation()
+{
+	if (AActionGameCharacter* ActionGameCharacter = BoundCharacter.Get())
+	{
+		ActionGameCharacter->OnCharacterDataChanged.RemoveAll(this);
+	}
 
-		if (Data.CharacterAnimDataAsset)
-		{
-			return Data.CharacterAnimDataAsset->CharacterAnimationData.IdleAnimationAsset;
-		}
+	if (UInventoryComponent* InventoryComponent = BoundInventoryComponent.Get())
+	{
+		InventoryComponent->OnEquippedItemChanged.RemoveAll(this);
 	}
 
-	return DefaultCharacterAnimDataAsset ? DefaultCharacterAnimDataAsset->CharacterAnimationData.IdleAnimationAsset : nullptr;
+	BoundCharacter.Reset();
+	BoundInventoryComponent.Reset();
+
+	Super::NativeUninitializeAnimation();
 }
 
-UBlendSpace* UAG_AnimInstance::GetCrouchLocomotionBlendspace() const
+const UItemStaticData* UAG_AnimInstance::GetEquippedItemData() const
 {
-	if (AActionGameCharacter* ActionGameCharacter = Cast<AActionGameCharacter>(GetOwningActor()))
-	{
-		if (const UItemStaticData* ItemData = GetEquippedItemData())
-		{
-			if (ItemData->CharacterAnimationData.CrouchMovementBlendspace)
-			{
-				return ItemData->CharacterAnimationData.CrouchMovementBlendspace;
-			}
-		}
+	AActionGameCharacter* ActionGameCharacter = Cast<AActionGameCharacter>(GetOwningActor());
+	UInventoryComponent* InventoryComponent = ActionGameCharacter ? ActionGameCharacter->GetInventoryComponent() : nullptr;
+	UInventoryItemInstance* ItemInstance = InventoryComponent ? InventoryComponent->GetEquippedItem() : nullptr;
 
-		FCharacterData Data = ActionGameCharacter->GetCharacterData();
+	return ItemInstance ? ItemInstance->GetItemStaticData() : nullptr;
 
-		if (Data.CharacterAnimDataAsset)
-		{
-			return Data.CharacterAnimDataAsset->CharacterAnimationData.CrouchMovementBlendspace;
-		}
-	}
+}
 
-	return DefaultCharacterAnimDataAsset ? DefaultCharacterAnimDataAsset->CharacterAnimationData.CrouchMovementBlendspace : nullptr;
+void UAG_AnimInstance::MarkAnimationDataDirty()
+{
+	bAnimationDataDirty = true;
 }
 
-UAnimSequenceBase* UAG_AnimInstance::GetCrouchIdleAnimation() const
+void UAG_AnimInstance::ResolveAnimationData()
 {
+	static const FCharacterAnimationData EmptyAnimationData;
+
+	bAnimationDataDirty = false;
+
+	const FCharacterAnimationData* ItemAnimationData = &EmptyAnimationData;
+	// Characters without an anim data asset of their own use the default one, as do non character owners.
+	const FCharacterAnimationData* BaseAnimationData = DefaultCharacterAnimDataAsset ? &DefaultCharacterAnimDataAsset->CharacterAnimationData : &EmptyAnimationData;
+
 	if (AActionGameCharacter* ActionGameCharacter = Cast<AActionGameCharacter>(GetOwningActor()))
 	{
 		if (const UItemStaticData* ItemData = GetEquippedItemData())
 		{
-			if (ItemData->CharacterAnimationData.CrouchIdleAnimationAsset)
-			{
-				return ItemData->CharacterAnimationData.CrouchIdleAnimationAsset;
-			}
+			ItemAnimationData = &ItemData->CharacterAnimationData;
+		}
+		else if (UInventoryComponent* InventoryComponent = ActionGameCharacter->GetInventoryComponent())
+		{
+			// The equipped instance can replicate before its static data class, try again next update.
+			bAnimationDataDirty = InventoryComponent->GetEquippedItem() != nullptr;
 		}
 
-		FCharacterData Data = ActionGameCharacter->GetCharacterData();
+		const FCharacterData Data = ActionGameCharacter->GetCharacterData();
 
 		if (Data.CharacterAnimDataAsset)
 		{
-			return Data.CharacterAnimDataAsset->CharacterAnimationData.CrouchIdleAnimationAsset;
+			BaseAnimationData = &Data.CharacterAnimDataAsset->CharacterAnimationData;
 		}
 	}
 
-	return DefaultCharacterAnimDataAsset ? DefaultCharacterAnimDataAsset->CharacterAnimationData.CrouchIdleAnimationAsset : nullptr;
+	ResolvedAnimationData.MovementBlendspace = ItemAnimationData->MovementBlendspace ? ItemAnimationData->MovementBlendspace : BaseAnimationData->MovementBlendspace;
+	ResolvedAnimationData.IdleAnimationAsset = ItemAnimationData->IdleAnimationAsset ? ItemAnimationData->IdleAnimationAsset : BaseAnimationData->IdleAnimationAsset;
+	ResolvedAnimationData.CrouchMovementBlendspace = ItemAnimationData->CrouchMovementBlendspace ? ItemAnimationData->CrouchMovementBlendspace : BaseAnimationData->CrouchMovementBlendspace;
+	ResolvedAnimationData.CrouchIdleAnimationAsset = ItemAnimationData->CrouchIdleAnimationAsset ? ItemAnimationData->CrouchIdleAnimationAsset : BaseAnimationData->CrouchIdleAnimationAsset;
+}
+
+UBlendSpace* UAG_AnimInstance::GetLocomotionBlendspace() const
+{
+	return ResolvedAnimationData.MovementBlendspace;
+}
+
+UAnimSequenceBase* UAG_AnimInstance::GetIdleAnimation() const
+{
+	return ResolvedAnimationData.IdleAnimationAsset;
+}
+
+UBlendSpace* UAG_AnimInstance::GetCrouchLocomotionBlendspace() const
+{
+	return ResolvedAnimationData.CrouchMovementBlendspace;
+}
+
+UAnimSequenceBase* UAG_AnimInstance::GetCrouchIdleAnimation() const
+{
+	return ResolvedAnimationData.CrouchIdleAnimationAsset;
 }
\ No newline at end of file
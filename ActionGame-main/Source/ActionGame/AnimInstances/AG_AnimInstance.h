@@ -4,9 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "ActionGameTypes.h"
 #include "AG_AnimInstance.generated.h"
 
 class UItemStaticData;
+class AActionGameCharacter;
+class UInventoryComponent;
 
 UCLASS()
 class ACTIONGAME_API UAG_AnimInstance : public UAnimInstance
@@ -15,8 +18,18 @@ class ACTIONGAME_API UAG_AnimInstance : public UAnimInstance
 	
 protected:
 
+	virtual void NativeInitializeAnimation() override;
+
+	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+
+	virtual void NativeUninitializeAnimation() override;
+
 	const UItemStaticData* GetEquippedItemData() const;
 
+	void MarkAnimationDataDirty();
+
+	void ResolveAnimationData();
+
 	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe))
 	class UBlendSpace* GetLocomotionBlendspace() const;
 
@@ -31,4 +44,15 @@ protected:
 
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Animation")
 	class UCharacterAnimDataAsset* DefaultCharacterAnimDataAsset;
+
+	// Equipped item animations layered over the character (or default) ones. Only written on the game thread in
+	// NativeUpdateAnimation, before the worker thread update reads it through the thread safe getters.
+	UPROPERTY(Transient)
+	FCharacterAnimationData ResolvedAnimationData;
+
+	bool bAnimationDataDirty = true;
+
+	TWeakObjectPtr<AActionGameCharacter> BoundCharacter;
+
+	TWeakObjectPtr<UInventoryComponent> BoundInventoryComponent;
 };
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ActionGameTypes.h"
+#include "WallRunDataAsset.generated.h"
+
+/**
+ * 
+ */
+UCLASS(BlueprintType)
+class ACTIONGAME_API UWallRunDataAsset : public UDataAsset
+{
+	GENERATED_BODY()
+	
+public:
+
+	UPROPERTY(EditDefaultsOnly)
+	FWallRunData WallRunData;
+};
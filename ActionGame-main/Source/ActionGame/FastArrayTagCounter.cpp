@@ -5,13 +5,14 @@
 
 int32 FFastArrayTagCounter::GetTagCount(FGameplayTag InTag) const
 {
-	for (auto ItemIter = TagArray.CreateConstIterator(); ItemIter; ++ItemIter)
+	if (bTagIndexMapDirty)
 	{
-		const FFastArrayTagCounterRecord& TagRecord = *ItemIter;
-		if (TagRecord.Tag == InTag)
-		{
-			return TagRecord.Count;
-		}
+		RebuildTagIndexMap();
+	}
+
+	if (const int32* Index = TagIndexMap.Find(InTag))
+	{
+		return TagArray[*Index].Count;
 	}
 
 	return 0;
@@ -19,27 +20,33 @@ int32 FFastArrayTagCounter::GetTagCount(FGameplayTag InTag) const
 
 void FFastArrayTagCounter::AddTagCount(FGameplayTag InTag, int32 Delta)
 {
-	for (auto ItemIter = TagArray.CreateIterator(); ItemIter; ++ItemIter)
+	if (bTagIndexMapDirty)
 	{
-		FFastArrayTagCounterRecord& TagRecord = *ItemIter;
-		if (TagRecord.Tag == InTag)
+		RebuildTagIndexMap();
+	}
+
+	if (const int32* IndexPtr = TagIndexMap.Find(InTag))
+	{
+		const int32 Index = *IndexPtr;
+
+		FFastArrayTagCounterRecord& TagRecord = TagArray[Index];
+		TagRecord.Count += Delta;
+
+		if (TagRecord.Count <= 0)
 		{
-			TagRecord.Count += Delta;
-
-			if (TagRecord.Count <= 0)
-			{
-				ItemIter.RemoveCurrent();
-				MarkArrayDirty();
-			}
-			else
-			{
-				MarkItemDirty(TagRecord);
-			}
-
-			return;
+			RemoveRecordAt(Index);
+			MarkArrayDirty();
 		}
+		else
+		{
+			MarkItemDirty(TagRecord);
+		}
+
+		return;
 	}
 
+	TagIndexMap.Add(InTag, TagArray.Num());
+
 	FFastArrayTagCounterRecord& Item = TagArray.AddDefaulted_GetRef();
 	Item.Count = Delta;
 	Item.Tag = InTag;
@@ -49,4 +56,47 @@ void FFastArrayTagCounter::AddTagCount(FGameplayTag InTag, int32 Delta)
 const TArray<FFastArrayTagCounterRecord>& FFastArrayTagCounter::GetTagArray() const
 {
 	return TagArray;
+}
+
+void FFastArrayTagCounter::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
+{
+	// Records are removed after this callback, so the indices can only be rebuilt on the next lookup.
+	bTagIndexMapDirty = true;
+}
+
+void FFastArrayTagCounter::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
+{
+	// Removed records of the same update are only swapped out after the Post callbacks, rebuilding here would
+	// leave their indices in the map.
+	bTagIndexMapDirty = true;
+}
+
+void FFastArrayTagCounter::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
+{
+	bTagIndexMapDirty = true;
+}
+
+void FFastArrayTagCounter::RemoveRecordAt(int32 Index)
+{
+	TagIndexMap.Remove(TagArray[Index].Tag);
+
+	// Record order doesn't matter for replication, swapping keeps every other index valid but the moved one.
+	TagArray.RemoveAtSwap(Index);
+
+	if (TagArray.IsValidIndex(Index))
+	{
+		TagIndexMap.Add(TagArray[Index].Tag, Index);
+	}
+}
+
+void FFastArrayTagCounter::RebuildTagIndexMap() const
+{
+	TagIndexMap.Reset();
+
+	for (int32 Index = 0; Index < TagArray.Num(); ++Index)
+	{
+		TagIndexMap.Add(TagArray[Index].Tag, Index);
+	}
+
+	bTagIndexMapDirty = false;
 }
\ No newline at end of file
@@ -39,10 +39,24 @@ public:
 
 	const TArray<FFastArrayTagCounterRecord>& GetTagArray() const;
 
+	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
+	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
+
 protected:
 	
 	UPROPERTY()
 	TArray<FFastArrayTagCounterRecord> TagArray;
+
+	void RemoveRecordAt(int32 Index);
+
+	void RebuildTagIndexMap() const;
+
+	// Not replicated. Maps each tag to its record in TagArray, maintained incrementally on the server
+	// and rebuilt from the replicated array on clients.
+	mutable TMap<FGameplayTag, int32> TagIndexMap;
+
+	mutable bool bTagIndexMapDirty = false;
 };
 
 template<>
@@ -4,6 +4,7 @@
 #include "Inventory/InventoryItemInstance.h"
 #include "ActionGameStatics.h"
 #include "Actors/ItemActor.h"
+#include "Subsystems/ItemActorPoolSubsystem.h"
 #include "Net/UnrealNetwork.h"
 #include "GameFramework/Character.h"
 #include "AbilitySystemComponent.h"
@@ -31,20 +32,23 @@ void UInventoryItemInstance::Init(TSubclassOf<UItemStaticData> InItemStaticDataC
 
 void UInventoryItemInstance::OnEquipped(AActor* InOwner)
 {
-	if (UWorld* World = InOwner->GetWorld())
+	UWorld* World = InOwner->GetWorld();
+
+	if (UItemActorPoolSubsystem* ItemActorPool = World ? World->GetSubsystem<UItemActorPoolSubsystem>() : nullptr)
 	{
 		const UItemStaticData* StaticData = GetItemStaticData();
 
-		FTransform Transform;
-		ItemActor = World->SpawnActorDeferred<AItemActor>(StaticData->ItemActorClass, Transform, InOwner);
-		ItemActor->Init(this);
-		ItemActor->OnEquipped();
-		ItemActor->FinishSpawning(Transform);
+		ItemActor = ItemActorPool->AcquireItemActor(StaticData->ItemActorClass, this, InOwner);
 
-		ACharacter* Character = Cast<ACharacter>(InOwner);
-		if (USkeletalMeshComponent* SkeletalMesh = Character ? Character->GetMesh() : nullptr)
+		if (ItemActor)
 		{
-			ItemActor->AttachToComponent(SkeletalMesh, FAttachmentTransformRules::SnapToTargetNotIncludingScale, StaticData->AttachmentSocket);
+			ItemActor->OnEquipped();
+
+			ACharacter* Character = Cast<ACharacter>(InOwner);
+			if (USkeletalMeshComponent* SkeletalMesh = Character ? Character->GetMesh() : nullptr)
+			{
+				ItemActor->AttachToComponent(SkeletalMesh, FAttachmentTransformRules::SnapToTargetNotIncludingScale, StaticData->AttachmentSocket);
+			}
 		}
 	}
 
@@ -59,7 +63,17 @@ void UInventoryItemInstance::OnUnequipped(AActor* InOwner)
 {
 	if (ItemActor)
 	{
-		ItemActor->Destroy();
+		UWorld* World = ItemActor->GetWorld();
+
+		if (UItemActorPoolSubsystem* ItemActorPool = World ? World->GetSubsystem<UItemActorPoolSubsystem>() : nullptr)
+		{
+			ItemActorPool->ReleaseItemActor(ItemActor);
+		}
+		else
+		{
+			ItemActor->Destroy();
+		}
+
 		ItemActor = nullptr;
 	}
 
@@ -89,6 +103,14 @@ AItemActor* UInventoryItemInstance::GetItemActor() const
 	return ItemActor;
 }
 
+void UInventoryItemInstance::OnItemActorReleased(const AItemActor* InItemActor)
+{
+	if (ItemActor == InItemActor)
+	{
+		ItemActor = nullptr;
+	}
+}
+
 void UInventoryItemInstance::TryGrantAbilities(AActor* InOwner)
 {
 	if (InOwner && InOwner->HasAuthority())
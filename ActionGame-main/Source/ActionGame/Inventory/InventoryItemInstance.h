@@ -41,6 +41,9 @@ public:
 	UFUNCTION(BlueprintPure)
 	AItemActor* GetItemActor() const;
 
+	// Called when InItemActor goes back to the item actor pool, the pool may hand it to another instance.
+	void OnItemActorReleased(const AItemActor* InItemActor);
+
 	int32 GetQuantity() const {return Quantity;}
 
 	void AddItems(int32 Count);
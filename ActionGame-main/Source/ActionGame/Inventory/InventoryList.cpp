@@ -3,6 +3,7 @@
 
 #include "Inventory/InventoryList.h"
 #include "Inventory/InventoryItemInstance.h"
+#include "ActorComponents/InventoryComponent.h"
 #include "ActionGameStatics.h"
 #include "ActionGameTypes.h"
 
@@ -11,29 +12,74 @@ void FInventoryList::AddItem(TSubclassOf<UItemStaticData> InItemStaticDataClass)
 	FInventoryListItem& Item = Items.AddDefaulted_GetRef();
 	Item.ItemInstance = NewObject<UInventoryItemInstance>();
 	Item.ItemInstance->Init(InItemStaticDataClass, UActionGameStatics::GetItemStaticData(InItemStaticDataClass)->MaxStackCount);
+	AddToIndices(Item.ItemInstance);
 	MarkItemDirty(Item);
 
+	if (OwnerComponent)
+	{
+		OwnerComponent->AddReplicatedItemInstance(Item.ItemInstance);
+	}
+
 }
 
 void FInventoryList::AddItem(UInventoryItemInstance* InItemInstance)
 {
 	FInventoryListItem& Item = Items.AddDefaulted_GetRef();
 	Item.ItemInstance = InItemInstance;
+	AddToIndices(InItemInstance);
 	MarkItemDirty(Item);
+
+	if (OwnerComponent)
+	{
+		OwnerComponent->AddReplicatedItemInstance(InItemInstance);
+	}
+}
+
+void FInventoryList::AddFullStacks(TSubclassOf<UItemStaticData> InItemStaticDataClass, int32 NumStacks)
+{
+	const UItemStaticData* StaticData = UActionGameStatics::GetItemStaticData(InItemStaticDataClass);
+
+	if (!StaticData || NumStacks <= 0)
+	{
+		return;
+	}
+
+	Items.Reserve(Items.Num() + NumStacks);
+
+	for (int32 i = 0; i < NumStacks; ++i)
+	{
+		FInventoryListItem& Item = Items.AddDefaulted_GetRef();
+		Item.ItemInstance = NewObject<UInventoryItemInstance>();
+		Item.ItemInstance->Init(InItemStaticDataClass, StaticData->MaxStackCount);
+		AddToIndices(Item.ItemInstance);
+		MarkItemDirty(Item);
+
+		if (OwnerComponent)
+		{
+			OwnerComponent->AddReplicatedItemInstance(Item.ItemInstance);
+		}
+	}
 }
 
 void FInventoryList::RemoveItem(TSubclassOf<UItemStaticData> InItemStaticDataClass)
 {
-	for (auto ItemIter = Items.CreateIterator(); ItemIter; ++ItemIter)
+	RebuildIndicesIfDirty();
+
+	UInventoryItemInstance* InstanceToRemove = nullptr;
+
+	for (const auto& ClassInstances : InstancesByClass)
 	{
-		FInventoryListItem& Item = *ItemIter;
-		if (Item.ItemInstance && Item.ItemInstance->GetItemStaticData()->IsA(InItemStaticDataClass))
+		if (ClassInstances.Key && ClassInstances.Key->IsChildOf(InItemStaticDataClass) && ClassInstances.Value.Num() > 0)
 		{
-			ItemIter.RemoveCurrent();
-			MarkArrayDirty();
+			InstanceToRemove = ClassInstances.Value[0];
 			break;
 		}
 	}
+
+	if (InstanceToRemove)
+	{
+		RemoveItem(InstanceToRemove);
+	}
 }
 
 void FInventoryList::RemoveItem(UInventoryItemInstance* InItemInstance)
@@ -43,48 +89,164 @@ void FInventoryList::RemoveItem(UInventoryItemInstance* InItemInstance)
 		FInventoryListItem& Item = *ItemIter;
 		if (Item.ItemInstance && Item.ItemInstance == InItemInstance)
 		{
+			RemoveFromIndices(InItemInstance);
 			ItemIter.RemoveCurrent();
 			MarkArrayDirty();
+
+			if (OwnerComponent)
+			{
+				OwnerComponent->RemoveReplicatedItemInstance(InItemInstance);
+			}
 			break;
 		}
 	}
 }
 
-TArray<UInventoryItemInstance*> FInventoryList::GetAllInstancesWithTag(FGameplayTag InTag)
+void FInventoryList::GetAllInstancesWithTag(FGameplayTag InTag, FInventoryInstanceArray& OutInstances) const
 {
-	TArray<UInventoryItemInstance*> OutInstances;
+	RebuildIndicesIfDirty();
 
-	for (auto ItemIter = Items.CreateIterator(); ItemIter; ++ItemIter)
+	OutInstances.Reset();
+
+	if (const TArray<UInventoryItemInstance*>* TagInstances = InstancesByTag.Find(InTag))
 	{
-		FInventoryListItem& Item = *ItemIter;
+		OutInstances.Append(*TagInstances);
+	}
+}
+
+void FInventoryList::GetAllAvailableInstancesOfType(TSubclassOf<UItemStaticData> InItemStaticDataClass, FInventoryInstanceArray& OutInstances) const
+{
+	RebuildIndicesIfDirty();
 
-		if (Item.ItemInstance->GetItemStaticData()->InventoryTags.Contains(InTag))
+	OutInstances.Reset();
+
+	for (const auto& ClassInstances : InstancesByClass)
+	{
+		if (!ClassInstances.Key || !ClassInstances.Key->IsChildOf(InItemStaticDataClass))
+		{
+			continue;
+		}
+
+		// Every instance in a bucket shares the same static data, resolve it once.
+		const UItemStaticData* StaticData = UActionGameStatics::GetItemStaticData(ClassInstances.Key);
+
+		for (UInventoryItemInstance* ItemInstance : ClassInstances.Value)
 		{
-			OutInstances.Add(Item.ItemInstance);
+			if (StaticData->MaxStackCount > ItemInstance->GetQuantity())
+			{
+				OutInstances.Add(ItemInstance);
+			}
 		}
 	}
+}
+
+const TArray<UInventoryItemInstance*>& FInventoryList::GetEquippableInstances() const
+{
+	RebuildIndicesIfDirty();
 
-	return OutInstances;
+	return EquippableInstances;
 }
 
-TArray<UInventoryItemInstance*> FInventoryList::GetAllAvailableInstancesOfType(TSubclassOf<UItemStaticData> InItemStaticDataClass)
+bool FInventoryList::ContainsInstance(const UInventoryItemInstance* InItemInstance) const
 {
-	TArray<UInventoryItemInstance*> OutInstances;
+	if (!InItemInstance)
+	{
+		return false;
+	}
 
-	for (auto ItemIter = Items.CreateIterator(); ItemIter; ++ItemIter)
+	RebuildIndicesIfDirty();
+
+	const TArray<UInventoryItemInstance*>* ClassInstances = InstancesByClass.Find(InItemInstance->ItemStaticDataClass);
+
+	return ClassInstances && ClassInstances->Contains(InItemInstance);
+}
+
+UInventoryItemInstance* FInventoryList::FindFirstInstanceOfClass(TSubclassOf<UItemStaticData> InItemStaticDataClass) const
+{
+	RebuildIndicesIfDirty();
+
+	const TArray<UInventoryItemInstance*>* ClassInstances = InstancesByClass.Find(InItemStaticDataClass);
+
+	return ClassInstances && ClassInstances->Num() > 0 ? (*ClassInstances)[0] : nullptr;
+}
+
+void FInventoryList::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
+{
+	bIndicesDirty = true;
+}
+
+void FInventoryList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
+{
+	bIndicesDirty = true;
+}
+
+void FInventoryList::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
+{
+	bIndicesDirty = true;
+}
+
+void FInventoryList::AddToIndices(UInventoryItemInstance* InItemInstance) const
+{
+	if (!InItemInstance)
 	{
-		FInventoryListItem& Item = *ItemIter;
+		return;
+	}
 
-		const UItemStaticData* StaticData = Item.ItemInstance->GetItemStaticData();
+	InstancesByClass.FindOrAdd(InItemInstance->ItemStaticDataClass).Add(InItemInstance);
 
-		const bool bSameType = StaticData->IsA(InItemStaticDataClass);
-		const bool bHasCapacity = StaticData->MaxStackCount > Item.ItemInstance->GetQuantity();
+	if (const UItemStaticData* StaticData = InItemInstance->GetItemStaticData())
+	{
+		for (FGameplayTag InvTag : StaticData->InventoryTags)
+		{
+			InstancesByTag.FindOrAdd(InvTag).Add(InItemInstance);
+		}
 
-		if (bSameType && bHasCapacity)
+		if (StaticData->bCanBeEquipped)
 		{
-			OutInstances.Add(Item.ItemInstance);
+			EquippableInstances.Add(InItemInstance);
 		}
 	}
+}
+
+void FInventoryList::RemoveFromIndices(UInventoryItemInstance* InItemInstance) const
+{
+	if (TArray<UInventoryItemInstance*>* ClassInstances = InstancesByClass.Find(InItemInstance->ItemStaticDataClass))
+	{
+		ClassInstances->Remove(InItemInstance);
+	}
+
+	if (const UItemStaticData* StaticData = InItemInstance->GetItemStaticData())
+	{
+		for (FGameplayTag InvTag : StaticData->InventoryTags)
+		{
+			if (TArray<UInventoryItemInstance*>* TagInstances = InstancesByTag.Find(InvTag))
+			{
+				TagInstances->Remove(InItemInstance);
+			}
+		}
 
-	return OutInstances;
-}
\ No newline at end of file
+		if (StaticData->bCanBeEquipped)
+		{
+			EquippableInstances.Remove(InItemInstance);
+		}
+	}
+}
+
+void FInventoryList::RebuildIndicesIfDirty() const
+{
+	if (!bIndicesDirty)
+	{
+		return;
+	}
+
+	InstancesByClass.Reset();
+	InstancesByTag.Reset();
+	EquippableInstances.Reset();
+
+	for (const FInventoryListItem& Item : Items)
+	{
+		AddToIndices(Item.ItemInstance);
+	}
+
+	bIndicesDirty = false;
+}
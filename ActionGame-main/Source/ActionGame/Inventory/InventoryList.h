@@ -7,6 +7,9 @@
 #include "InventoryList.generated.h"
 
 class UInventoryItemInstance;
+class UInventoryComponent;
+
+typedef TArray<UInventoryItemInstance*, TInlineAllocator<8>> FInventoryInstanceArray;
 
 USTRUCT(BlueprintType)
 struct FInventoryListItem : public FFastArraySerializerItem
@@ -33,24 +36,59 @@ struct FInventoryList : public FFastArraySerializer
 	void AddItem(TSubclassOf<UItemStaticData> InItemStaticDataClass);
 	void AddItem(UInventoryItemInstance* InItemInstance);
 
+	// Adds NumStacks new instances of the class, each holding a full stack.
+	void AddFullStacks(TSubclassOf<UItemStaticData> InItemStaticDataClass, int32 NumStacks);
+
 	void RemoveItem(TSubclassOf<UItemStaticData> InItemStaticDataClass);
 	void RemoveItem(UInventoryItemInstance* InItemInstance);
 
 	TArray<FInventoryListItem>& GetItemsRef() {return Items;}
 
-	TArray<UInventoryItemInstance*> GetAllInstancesWithTag(FGameplayTag InTag);
+	// Instances added/removed on the server are registered with/removed from the owner's replicated subobject list.
+	void SetOwnerComponent(UInventoryComponent* InOwnerComponent) {OwnerComponent = InOwnerComponent;}
+
+	void GetAllInstancesWithTag(FGameplayTag InTag, FInventoryInstanceArray& OutInstances) const;
+
+	void GetAllAvailableInstancesOfType(TSubclassOf<UItemStaticData> InItemStaticDataClass, FInventoryInstanceArray& OutInstances) const;
 
-	TArray<UInventoryItemInstance*> GetAllAvailableInstancesOfType(TSubclassOf<UItemStaticData> InItemStaticDataClass);
+	// Instances that can be equipped, in the order they were added.
+	const TArray<UInventoryItemInstance*>& GetEquippableInstances() const;
 
+	// Looked up through the class buckets, only the instances sharing the static data class are searched.
+	bool ContainsInstance(const UInventoryItemInstance* InItemInstance) const;
+
+	UInventoryItemInstance* FindFirstInstanceOfClass(TSubclassOf<UItemStaticData> InItemStaticDataClass) const;
+
+	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
+	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
 
 protected:
 
 	UPROPERTY()
 	TArray<FInventoryListItem> Items;
+
+	UInventoryComponent* OwnerComponent = nullptr;
+
+	void AddToIndices(UInventoryItemInstance* InItemInstance) const;
+
+	void RemoveFromIndices(UInventoryItemInstance* InItemInstance) const;
+
+	void RebuildIndicesIfDirty() const;
+
+	// Not replicated. Instances bucketed by exact static data class and by inventory tag, kept in sync on the
+	// server by AddItem/RemoveItem and rebuilt lazily on clients after replication.
+	mutable TMap<TSubclassOf<UItemStaticData>, TArray<UInventoryItemInstance*>> InstancesByClass;
+
+	mutable TMap<FGameplayTag, TArray<UInventoryItemInstance*>> InstancesByTag;
+
+	mutable TArray<UInventoryItemInstance*> EquippableInstances;
+
+	mutable bool bIndicesDirty = false;
 };
 
 template<>
 struct TStructOpsTypeTraits<FInventoryList> : public TStructOpsTypeTraitsBase2<FInventoryList>
 {
 	enum {WithNetDeltaSerializer = true};
-};
\ No newline at end of file
+};
@@ -19,12 +19,18 @@ void AAmmoItemActor::InitInternal()
 	{
 		if (WeaponData->StaticMesh)
 		{
-			UStaticMeshComponent* StaticComp = NewObject<UStaticMeshComponent>(this, UStaticMeshComponent::StaticClass(), TEXT("MeshComponent"));
-			StaticComp->RegisterComponent();
-			StaticComp->SetStaticMesh(WeaponData->StaticMesh);
-			StaticComp->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+			// Pooled actors keep their mesh component between items.
+			UStaticMeshComponent* StaticComp = Cast<UStaticMeshComponent>(MeshComponent);
+			if (!StaticComp)
+			{
+				StaticComp = NewObject<UStaticMeshComponent>(this, UStaticMeshComponent::StaticClass(), TEXT("MeshComponent"));
+				StaticComp->RegisterComponent();
+				StaticComp->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+
+				MeshComponent = StaticComp;
+			}
 
-			MeshComponent = StaticComp;
+			StaticComp->SetStaticMesh(WeaponData->StaticMesh);
 		}
 	}
 }
\ No newline at end of file
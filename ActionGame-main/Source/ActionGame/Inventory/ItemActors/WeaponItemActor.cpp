@@ -6,9 +6,8 @@
 #include "Inventory/InventoryItemInstance.h"
 #include "ActionGameTypes.h"
 
-#include "Kismet/GameplayStatics.h"
+#include "Subsystems/WeaponImpactSubsystem.h"
 #include "PhysicalMaterials/AG_PhysicalMaterial.h"
-#include "NiagaraFunctionLibrary.h"
 
 AWeaponItemActor::AWeaponItemActor()
 {
@@ -32,67 +31,70 @@ void AWeaponItemActor::InitInternal()
 
 	if (const UWeaponStaticData* WeaponData = GetWeaponStaticData())
 	{
+		// Pooled actors keep their mesh component between items, only swap it out when the mesh type changes.
 		if (WeaponData->SkeletalMesh)
 		{
-			USkeletalMeshComponent* SkeletalComp = NewObject<USkeletalMeshComponent>(this, USkeletalMeshComponent::StaticClass(), TEXT("MeshComponent"));
-			if (SkeletalComp)
+			USkeletalMeshComponent* SkeletalComp = Cast<USkeletalMeshComponent>(MeshComponent);
+			if (!SkeletalComp)
 			{
+				ReleaseMeshComponent();
+
+				SkeletalComp = NewObject<USkeletalMeshComponent>(this, USkeletalMeshComponent::StaticClass(), MakeUniqueObjectName(this, USkeletalMeshComponent::StaticClass(), TEXT("MeshComponent")));
 				SkeletalComp->RegisterComponent();
-				SkeletalComp->SetSkeletalMesh(WeaponData->SkeletalMesh);
 				SkeletalComp->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
 
 				MeshComponent = SkeletalComp;
 			}
+
+			SkeletalComp->SetSkeletalMesh(WeaponData->SkeletalMesh);
 		}
 		else if(WeaponData->StaticMesh)
 		{
-			UStaticMeshComponent* StaticComp = NewObject<UStaticMeshComponent>(this, UStaticMeshComponent::StaticClass(), TEXT("MeshComponent"));
-			StaticComp->RegisterComponent();
-			StaticComp->SetStaticMesh(WeaponData->StaticMesh);
-			StaticComp->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+			UStaticMeshComponent* StaticComp = Cast<UStaticMeshComponent>(MeshComponent);
+			if (!StaticComp)
+			{
+				ReleaseMeshComponent();
+
+				StaticComp = NewObject<UStaticMeshComponent>(this, UStaticMeshComponent::StaticClass(), MakeUniqueObjectName(this, UStaticMeshComponent::StaticClass(), TEXT("MeshComponent")));
+				StaticComp->RegisterComponent();
+				StaticComp->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+
+				MeshComponent = StaticComp;
+			}
 
-			MeshComponent = StaticComp;
+			StaticComp->SetStaticMesh(WeaponData->StaticMesh);
+		}
+		else
+		{
+			ReleaseMeshComponent();
 		}
 	}
 }
 
-
-void AWeaponItemActor::PlayWeaponEffects(const FHitResult& InHitResult)
+void AWeaponItemActor::ReleaseMeshComponent()
 {
-	if (HasAuthority())
-	{
-		MulticastPlayWeaponEffects(InHitResult);
-	}
-	else
+	if (MeshComponent)
 	{
-		PlayWeaponEffectsInternal(InHitResult);
+		MeshComponent->DestroyComponent();
+		MeshComponent = nullptr;
 	}
 }
 
-void AWeaponItemActor::MulticastPlayWeaponEffects_Implementation(const FHitResult& InHitResult)
+
+void AWeaponItemActor::PlayWeaponEffects(const FHitResult& InHitResult)
 {
-	if (!Owner || Owner->GetLocalRole() != ROLE_AutonomousProxy)
+	UWeaponImpactSubsystem* WeaponImpacts = GetWorld()->GetSubsystem<UWeaponImpactSubsystem>();
+	if (!WeaponImpacts)
 	{
-		PlayWeaponEffectsInternal(InHitResult);
+		return;
 	}
-}
 
-void AWeaponItemActor::PlayWeaponEffectsInternal(const FHitResult& InHitResult)
-{
-	if (InHitResult.PhysMaterial.Get())
+	if (HasAuthority())
 	{
-		UAG_PhysicalMaterial* PhysicalMaterial = Cast<UAG_PhysicalMaterial>(InHitResult.PhysMaterial.Get());
-
-		if (PhysicalMaterial)
-		{
-			UGameplayStatics::PlaySoundAtLocation(this, PhysicalMaterial->PointImpactSound, InHitResult.ImpactPoint, 1.f);
-
-			UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, PhysicalMaterial->PointImpactVFX, InHitResult.ImpactPoint);
-		}
+		WeaponImpacts->QueueImpact(this, InHitResult);
 	}
-
-	if (const UWeaponStaticData* WeaponData = GetWeaponStaticData())
+	else
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, WeaponData->AttackSound, GetActorLocation(), 1.f);
+		WeaponImpacts->PlayImpactEffects(this, InHitResult.ImpactPoint, InHitResult.ImpactNormal, Cast<UAG_PhysicalMaterial>(InHitResult.PhysMaterial.Get()));
 	}
 }
\ No newline at end of file
@@ -25,13 +25,10 @@ public:
 
 protected:
 
-	UFUNCTION(NetMulticast, Reliable)
-	void MulticastPlayWeaponEffects(const FHitResult& InHitResult);
-
-	void PlayWeaponEffectsInternal(const FHitResult& InHitResult);
-
 	UPROPERTY()
 	UMeshComponent* MeshComponent = nullptr;
 
 	virtual void InitInternal() override;
+
+	void ReleaseMeshComponent();
 };
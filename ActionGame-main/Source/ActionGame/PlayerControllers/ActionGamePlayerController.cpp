@@ -5,6 +5,7 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "ActionGameGameMode.h"
+#include "ActionGameTags.h"
 
 void AActionGamePlayerController::RestartPlayerIn(float InTime)
 {
@@ -13,13 +14,21 @@ void AActionGamePlayerController::RestartPlayerIn(float InTime)
 	GetWorld()->GetTimerManager().SetTimer(RestartPlayerTimerHandle, this, &AActionGamePlayerController::RestartPlayer, InTime, false);
 }
 
+void AActionGamePlayerController::ClientPlayWeaponImpacts_Implementation(AWeaponItemActor* InWeapon, const TArray<FWeaponImpact>& InImpacts)
+{
+	if (UWeaponImpactSubsystem* WeaponImpacts = GetWorld()->GetSubsystem<UWeaponImpactSubsystem>())
+	{
+		WeaponImpacts->PlayReplicatedImpacts(InWeapon, InImpacts);
+	}
+}
+
 void AActionGamePlayerController::OnPossess(APawn* aPawn)
 {
 	Super::OnPossess(aPawn);
 
 	if (UAbilitySystemComponent* AbilityComponent = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(aPawn))
 	{
-		DeathStateTagDelegate = AbilityComponent->RegisterGameplayTagEvent(FGameplayTag::RequestGameplayTag(TEXT("State.Dead")), EGameplayTagEventType::NewOrRemoved).AddUObject(this, &AActionGamePlayerController::OnPawnDeathStateChanged);
+		DeathStateTagDelegate = AbilityComponent->RegisterGameplayTagEvent(ActionGameTags::State_Dead, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &AActionGamePlayerController::OnPawnDeathStateChanged);
 	}
 }
 
@@ -31,7 +40,7 @@ void AActionGamePlayerController::OnUnPossess()
 	{
 		if (UAbilitySystemComponent* AbilityComponent = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetPawn()))
 		{
-			AbilityComponent->UnregisterGameplayTagEvent(DeathStateTagDelegate, FGameplayTag::RequestGameplayTag(TEXT("State.Dead")), EGameplayTagEventType::NewOrRemoved);
+			AbilityComponent->UnregisterGameplayTagEvent(DeathStateTagDelegate, ActionGameTags::State_Dead, EGameplayTagEventType::NewOrRemoved);
 		}
 	}
 }
@@ -53,7 +62,7 @@ void AActionGamePlayerController::OnPawnDeathStateChanged(const FGameplayTag Cal
 		{
 			if (UAbilitySystemComponent* AbilityComponent = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetPawn()))
 			{
-				AbilityComponent->UnregisterGameplayTagEvent(DeathStateTagDelegate, FGameplayTag::RequestGameplayTag(TEXT("State.Dead")), EGameplayTagEventType::NewOrRemoved);
+				AbilityComponent->UnregisterGameplayTagEvent(DeathStateTagDelegate, ActionGameTags::State_Dead, EGameplayTagEventType::NewOrRemoved);
 			}
 		}
 	}
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
 #include "GameplayTagContainer.h"
+#include "Subsystems/WeaponImpactSubsystem.h"
 #include "ActionGamePlayerController.generated.h"
 
 
@@ -17,6 +18,10 @@ public:
 
 	void RestartPlayerIn(float InTime);
 
+	// The impacts of one weapon this frame that are close enough to this player's view.
+	UFUNCTION(Client, Unreliable)
+	void ClientPlayWeaponImpacts(AWeaponItemActor* InWeapon, const TArray<FWeaponImpact>& InImpacts);
+
 protected:
 
 	virtual void OnPossess(APawn* aPawn) override;
@@ -0,0 +1,233 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/FootstepSubsystem.h"
+
+#include "ActorComponents/FootstepsComponent.h"
+#include "PhysicalMaterials/AG_PhysicalMaterial.h"
+#include "Components/AudioComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
+#include "DrawDebugHelpers.h"
+#include "ActionGameStats.h"
+#include "ActionGameQueries.h"
+
+DECLARE_CYCLE_STAT(TEXT("FootstepSubsystem Tick"), STAT_FootstepSubsystemTick, STATGROUP_ActionGame);
+
+static TAutoConsoleVariable<float> CVarFootstepMaxDistance(
+	TEXT("FootstepMaxAudibleDistance"),
+	3000.f,
+	TEXT("Footsteps further than this from the local listener are dropped before tracing"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarFootstepAudioPoolSize(
+	TEXT("FootstepAudioPoolSize"),
+	16,
+	TEXT("Number of audio components footsteps are played through, the oldest one is reused when all are busy"),
+	ECVF_Default);
+
+void UFootstepSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FootstepTraceDelegate.BindUObject(this, &UFootstepSubsystem::OnFootstepTraceDone);
+}
+
+void UFootstepSubsystem::QueueFootstep(UFootstepsComponent* InFootstepsComponent, EFoot InFoot, const FVector& InLocation, UPrimitiveComponent* InFloorComponent)
+{
+	// Footsteps are only sounds, nothing to do where nobody can hear them.
+	if (GetWorld()->GetNetMode() == NM_DedicatedServer || !IsAudible(InLocation))
+	{
+		return;
+	}
+
+	if (const UAG_PhysicalMaterial* CachedPhysicalMaterial = InFootstepsComponent->GetCachedFootSurface(InFoot, InFloorComponent))
+	{
+		PlayFootstep(CachedPhysicalMaterial, InLocation);
+
+		if (ActionGameQueries::ShouldDrawDebug(CVarShowFootsteps))
+		{
+			DrawDebugFootstep(InLocation, CachedPhysicalMaterial, true);
+		}
+
+		return;
+	}
+
+	FQueuedFootstep& QueuedFootstep = QueuedFootsteps.AddDefaulted_GetRef();
+	QueuedFootstep.FootstepsComponent = InFootstepsComponent;
+	QueuedFootstep.FloorComponent = InFloorComponent;
+	QueuedFootstep.Location = InLocation;
+	QueuedFootstep.Foot = InFoot;
+}
+
+void UFootstepSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FootstepSubsystemTick);
+	CSV_SCOPED_TIMING_STAT(ActionGame, FootstepSubsystemTick);
+
+	Super::Tick(DeltaTime);
+
+	if (QueuedFootsteps.Num() == 0)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FootstepTrace), false);
+	QueryParams.bReturnPhysicalMaterial = true;
+
+	for (FQueuedFootstep& QueuedFootstep : QueuedFootsteps)
+	{
+		const UFootstepsComponent* FootstepsComponent = QueuedFootstep.FootstepsComponent.Get();
+
+		if (!FootstepsComponent)
+		{
+			continue;
+		}
+
+		QueryParams.ClearIgnoredActors();
+		QueryParams.AddIgnoredActor(FootstepsComponent->GetOwner());
+
+		QueuedFootstep.TraceId = NextTraceId++;
+
+		ACTIONGAME_COUNT_TRACES(1);
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, QueuedFootstep.Location, QueuedFootstep.Location + FVector::UpVector * -50.f, ECollisionChannel::ECC_WorldStatic,
+			QueryParams, FCollisionResponseParams::DefaultResponseParam, &FootstepTraceDelegate, QueuedFootstep.TraceId);
+
+		PendingFootsteps.Add(QueuedFootstep);
+	}
+
+	QueuedFootsteps.Reset();
+}
+
+void UFootstepSubsystem::OnFootstepTraceDone(const FTraceHandle& InTraceHandle, FTraceDatum& InTraceDatum)
+{
+	const int32 PendingIndex = PendingFootsteps.IndexOfByPredicate([&InTraceDatum](const FQueuedFootstep& PendingFootstep)
+	{
+		return PendingFootstep.TraceId == InTraceDatum.UserData;
+	});
+
+	if (PendingIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FQueuedFootstep PendingFootstep = PendingFootsteps[PendingIndex];
+	PendingFootsteps.RemoveAtSwap(PendingIndex, 1, false);
+
+	const FHitResult* HitResult = InTraceDatum.OutHits.Num() > 0 && InTraceDatum.OutHits[0].bBlockingHit ? &InTraceDatum.OutHits[0] : nullptr;
+	const UAG_PhysicalMaterial* PhysicalMaterial = HitResult ? Cast<UAG_PhysicalMaterial>(HitResult->PhysMaterial.Get()) : nullptr;
+
+	if (PhysicalMaterial)
+	{
+		if (UFootstepsComponent* FootstepsComponent = PendingFootstep.FootstepsComponent.Get())
+		{
+			FootstepsComponent->SetCachedFootSurface(PendingFootstep.Foot, PendingFootstep.FloorComponent.Get(), PhysicalMaterial);
+		}
+
+		PlayFootstep(PhysicalMaterial, PendingFootstep.Location);
+	}
+
+	if (ActionGameQueries::ShouldDrawDebug(CVarShowFootsteps))
+	{
+		DrawDebugFootstep(PendingFootstep.Location, PhysicalMaterial, HitResult != nullptr);
+	}
+}
+
+bool UFootstepSubsystem::IsAudible(const FVector& InLocation) const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+
+	if (!PlayerController || !PlayerController->IsLocalController())
+	{
+		return false;
+	}
+
+	FVector ListenerLocation;
+	FVector ListenerFrontDir;
+	FVector ListenerRightDir;
+	PlayerController->GetAudioListenerPosition(ListenerLocation, ListenerFrontDir, ListenerRightDir);
+
+	return FVector::DistSquared(ListenerLocation, InLocation) <= FMath::Square(CVarFootstepMaxDistance.GetValueOnGameThread());
+}
+
+void UFootstepSubsystem::PlayFootstep(const UAG_PhysicalMaterial* InPhysicalMaterial, const FVector& InLocation)
+{
+	USoundBase* FootstepSound = InPhysicalMaterial ? InPhysicalMaterial->FootstepSound : nullptr;
+
+	if (!FootstepSound)
+	{
+		return;
+	}
+
+	const int32 PoolSize = FMath::Max(1, CVarFootstepAudioPoolSize.GetValueOnGameThread());
+
+	// Prefer an idle component, otherwise cut off the one that started playing the longest ago.
+	UAudioComponent* AudioComponent = nullptr;
+
+	for (UAudioComponent* PooledAudioComponent : AudioComponentPool)
+	{
+		if (IsValid(PooledAudioComponent) && !PooledAudioComponent->IsPlaying())
+		{
+			AudioComponent = PooledAudioComponent;
+			break;
+		}
+	}
+
+	if (!AudioComponent)
+	{
+		if (AudioComponentPool.Num() < PoolSize)
+		{
+			AudioComponent = UGameplayStatics::SpawnSoundAtLocation(this, FootstepSound, InLocation, FRotator::ZeroRotator, 1.f, 1.f, 0.f, nullptr, nullptr, false);
+
+			if (AudioComponent)
+			{
+				AudioComponentPool.Add(AudioComponent);
+			}
+
+			return;
+		}
+
+		NextAudioComponentIndex = NextAudioComponentIndex % AudioComponentPool.Num();
+		AudioComponent = AudioComponentPool[NextAudioComponentIndex++];
+
+		if (!IsValid(AudioComponent))
+		{
+			return;
+		}
+	}
+
+	AudioComponent->SetSound(FootstepSound);
+	AudioComponent->SetWorldLocation(InLocation);
+	AudioComponent->Play();
+}
+
+void UFootstepSubsystem::DrawDebugFootstep(const FVector& InLocation, const UAG_PhysicalMaterial* InPhysicalMaterial, bool bHit) const
+{
+	if (bHit)
+	{
+		if (InPhysicalMaterial)
+		{
+			DrawDebugString(GetWorld(), InLocation, GetNameSafe(InPhysicalMaterial), nullptr, FColor::White, 4.f);
+		}
+
+		DrawDebugSphere(GetWorld(), InLocation, 16, 16, FColor::Red, false, 4.f);
+	}
+	else
+	{
+		DrawDebugLine(GetWorld(), InLocation, InLocation + FVector::UpVector * -50.f, FColor::Red, false, 4, 0, 1);
+		DrawDebugSphere(GetWorld(), InLocation, 16, 16, FColor::Red, false, 4.f);
+	}
+}
+
+TStatId UFootstepSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFootstepSubsystem, STATGROUP_Tickables);
+}
+
+bool UFootstepSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
\ No newline at end of file
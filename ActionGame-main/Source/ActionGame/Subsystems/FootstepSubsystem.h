@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActionGameTypes.h"
+#include "WorldCollision.h"
+#include "FootstepSubsystem.generated.h"
+
+class UFootstepsComponent;
+class UAG_PhysicalMaterial;
+class UAudioComponent;
+class UPrimitiveComponent;
+
+struct FQueuedFootstep
+{
+	TWeakObjectPtr<UFootstepsComponent> FootstepsComponent;
+
+	TWeakObjectPtr<UPrimitiveComponent> FloorComponent;
+
+	FVector Location = FVector::ZeroVector;
+
+	EFoot Foot = EFoot::Left;
+
+	uint32 TraceId = 0;
+};
+
+/**
+ * Resolves and plays the footsteps of every character. Inaudible steps are dropped before tracing, steps on a floor
+ * whose surface is already known play right away, the rest are traced together as one async batch and play next frame.
+ */
+UCLASS()
+class ACTIONGAME_API UFootstepSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	void QueueFootstep(UFootstepsComponent* InFootstepsComponent, EFoot InFoot, const FVector& InLocation, UPrimitiveComponent* InFloorComponent);
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	bool IsAudible(const FVector& InLocation) const;
+
+	void OnFootstepTraceDone(const FTraceHandle& InTraceHandle, FTraceDatum& InTraceDatum);
+
+	void PlayFootstep(const UAG_PhysicalMaterial* InPhysicalMaterial, const FVector& InLocation);
+
+	void DrawDebugFootstep(const FVector& InLocation, const UAG_PhysicalMaterial* InPhysicalMaterial, bool bHit) const;
+
+	FTraceDelegate FootstepTraceDelegate;
+
+	// Steps queued this frame, traced in the next Tick.
+	TArray<FQueuedFootstep> QueuedFootsteps;
+
+	// Steps with a trace in flight, matched to results through the trace user data.
+	TArray<FQueuedFootstep> PendingFootsteps;
+
+	uint32 NextTraceId = 1;
+
+	UPROPERTY()
+	TArray<UAudioComponent*> AudioComponentPool;
+
+	int32 NextAudioComponentIndex = 0;
+};
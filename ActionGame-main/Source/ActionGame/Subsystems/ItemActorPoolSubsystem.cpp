@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ItemActorPoolSubsystem.h"
+
+#include "Actors/ItemActor.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogActionGameItemActorPool, Log, All);
+
+static TAutoConsoleVariable<int32> CVarItemActorPoolMaxPerClass(
+	TEXT("ItemActorPoolMaxPerClass"),
+	16,
+	TEXT("Max number of parked item actors kept per item actor class, the rest are destroyed on release"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithWorld CmdItemActorPoolStats(
+	TEXT("ItemActorPoolStats"),
+	TEXT("Logs item actor pool stats for the current world"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UItemActorPoolSubsystem* ItemActorPool = World ? World->GetSubsystem<UItemActorPoolSubsystem>() : nullptr)
+		{
+			ItemActorPool->LogStats();
+		}
+	})
+);
+
+AItemActor* UItemActorPoolSubsystem::AcquireItemActor(TSubclassOf<AItemActor> ItemActorClass, UInventoryItemInstance* InItemInstance, AActor* InOwner)
+{
+	UWorld* World = GetWorld();
+
+	if (!World || !ItemActorClass)
+	{
+		return nullptr;
+	}
+
+	if (FItemActorPoolEntry* PoolEntry = PooledActors.Find(ItemActorClass))
+	{
+		while (PoolEntry->Actors.Num() > 0)
+		{
+			AItemActor* ItemActor = PoolEntry->Actors.Pop(false);
+
+			if (IsValid(ItemActor))
+			{
+				ItemActor->SetOwner(InOwner);
+				ItemActor->OnTakenFromPool();
+				ItemActor->Init(InItemInstance);
+
+				++NumReused;
+
+				return ItemActor;
+			}
+		}
+	}
+
+	FTransform Transform;
+	AItemActor* ItemActor = World->SpawnActorDeferred<AItemActor>(ItemActorClass, Transform, InOwner);
+
+	if (ItemActor)
+	{
+		ItemActor->Init(InItemInstance);
+		ItemActor->FinishSpawning(Transform);
+
+		++NumSpawned;
+	}
+
+	return ItemActor;
+}
+
+void UItemActorPoolSubsystem::ReleaseItemActor(AItemActor* InItemActor)
+{
+	if (!IsValid(InItemActor))
+	{
+		return;
+	}
+
+	FItemActorPoolEntry& PoolEntry = PooledActors.FindOrAdd(InItemActor->GetClass());
+
+	if (PoolEntry.Actors.Num() >= CVarItemActorPoolMaxPerClass.GetValueOnGameThread())
+	{
+		InItemActor->Destroy();
+
+		++NumDestroyed;
+
+		return;
+	}
+
+	InItemActor->OnReturnedToPool();
+
+	PoolEntry.Actors.Add(InItemActor);
+
+	++NumReleased;
+}
+
+void UItemActorPoolSubsystem::LogStats() const
+{
+	UE_LOG(LogActionGameItemActorPool, Log, TEXT("Item actor pool %s: Spawned %d, Reused %d, Released %d, Destroyed %d"), *GetNameSafe(GetWorld()), NumSpawned, NumReused, NumReleased, NumDestroyed);
+
+	for (const auto& PoolEntry : PooledActors)
+	{
+		UE_LOG(LogActionGameItemActorPool, Log, TEXT("  %s: %d parked"), *GetNameSafe(PoolEntry.Key), PoolEntry.Value.Actors.Num());
+	}
+}
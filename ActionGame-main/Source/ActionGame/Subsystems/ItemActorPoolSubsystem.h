@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemActorPoolSubsystem.generated.h"
+
+class AItemActor;
+class UInventoryItemInstance;
+
+USTRUCT()
+struct FItemActorPoolEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AItemActor*> Actors;
+};
+
+/**
+ * Recycles item actors (and the mesh components they create) across equip, unequip and pickup, so weapon
+ * cycling doesn't spawn and destroy an actor every time. Parked actors are hidden and net dormant.
+ */
+UCLASS()
+class ACTIONGAME_API UItemActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// Returns a pooled actor of the class if one is parked, otherwise spawns a new one. Either way it's initialized from the instance.
+	AItemActor* AcquireItemActor(TSubclassOf<AItemActor> ItemActorClass, UInventoryItemInstance* InItemInstance, AActor* InOwner);
+
+	void ReleaseItemActor(AItemActor* InItemActor);
+
+	void LogStats() const;
+
+protected:
+
+	UPROPERTY()
+	TMap<UClass*, FItemActorPoolEntry> PooledActors;
+
+	int32 NumSpawned = 0;
+
+	int32 NumReused = 0;
+
+	int32 NumReleased = 0;
+
+	int32 NumDestroyed = 0;
+};
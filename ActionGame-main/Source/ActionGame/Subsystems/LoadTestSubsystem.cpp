@@ -0,0 +1,369 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/LoadTestSubsystem.h"
+
+#include "ActionGameCharacter.h"
+#include "ActorComponents/AG_CharacterMovementComponent.h"
+#include "ActorComponents/InventoryComponent.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerStart.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DEFINE_CATEGORY(ActionGameLoadTest, true);
+
+DEFINE_LOG_CATEGORY_STATIC(LogActionGameLoadTest, Log, All);
+
+static const float LoadTestPhaseDurations[] = { 2.f, 3.f, 1.f, 1.5f, 1.5f };
+static_assert(UE_ARRAY_COUNT(LoadTestPhaseDurations) == static_cast<int32>(ELoadTestBotPhase::Num), "Every load test phase needs a duration");
+
+static FAutoConsoleCommandWithWorldAndArgs CmdLoadTestStart(
+	TEXT("LoadTest.Start"),
+	TEXT("Spawns bots that loop through the game's movement and combat on the server. Args: <Bots> [Seconds, 0 runs until LoadTest.Stop]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (ULoadTestSubsystem* LoadTest = World ? World->GetSubsystem<ULoadTestSubsystem>() : nullptr)
+		{
+			const int32 NumBots = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 16;
+			const float Duration = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 0.f;
+
+			LoadTest->StartLoadTest(NumBots, Duration);
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorld CmdLoadTestStop(
+	TEXT("LoadTest.Stop"),
+	TEXT("Stops the running load test and destroys its bots"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (ULoadTestSubsystem* LoadTest = World ? World->GetSubsystem<ULoadTestSubsystem>() : nullptr)
+		{
+			LoadTest->StopLoadTest();
+		}
+	})
+);
+
+bool ULoadTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+void ULoadTestSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	int32 NumBots = 0;
+	if (FParse::Value(FCommandLine::Get(), TEXT("LoadTestBots="), NumBots) && NumBots > 0)
+	{
+		float Duration = 60.f;
+		FParse::Value(FCommandLine::Get(), TEXT("LoadTestSeconds="), Duration);
+
+		bExitWhenDone = true;
+		StartLoadTest(NumBots, Duration);
+	}
+}
+
+void ULoadTestSubsystem::Deinitialize()
+{
+	// The bots go away with the world, only the capture needs closing.
+#if CSV_PROFILER
+	if (bStartedCsvCapture && FCsvProfiler::Get())
+	{
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+	bStartedCsvCapture = false;
+
+	Bots.Reset();
+	bRunning = false;
+
+	Super::Deinitialize();
+}
+
+void ULoadTestSubsystem::StartLoadTest(int32 InNumBots, float InDuration)
+{
+	UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogActionGameLoadTest, Warning, TEXT("Load tests only run on the server"));
+		return;
+	}
+
+	StopLoadTest();
+
+	for (int32 BotIndex = 0; BotIndex < InNumBots; ++BotIndex)
+	{
+		if (AActionGameCharacter* Character = SpawnBot(BotIndex))
+		{
+			FLoadTestBot& Bot = Bots.AddDefaulted_GetRef();
+			Bot.Character = Character;
+			Bot.MoveDirection = FRotator(0.f, FMath::FRandRange(0.f, 360.f), 0.f).Vector();
+
+			// Spread the bots over the loop so the phases don't all line up on the same frames.
+			EnterPhase(Bot, static_cast<ELoadTestBotPhase>(BotIndex % static_cast<int32>(ELoadTestBotPhase::Num)));
+		}
+	}
+
+#if CSV_PROFILER
+	if (FCsvProfiler::Get() && !FCsvProfiler::Get()->IsCapturing())
+	{
+		FCsvProfiler::Get()->BeginCapture();
+		bStartedCsvCapture = true;
+	}
+#endif
+
+	TimeLeft = InDuration;
+	bRunning = true;
+
+	// The bots are AI controlled and have no connection of their own, per connection bytes need real clients.
+	const UNetDriver* NetDriver = World->GetNetDriver();
+	if (!NetDriver || NetDriver->ClientConnections.Num() == 0)
+	{
+		UE_LOG(LogActionGameLoadTest, Warning, TEXT("No clients connected, only total replication bytes will be recorded. Connect clients to the server to record bytes per connection"));
+	}
+
+	UE_LOG(LogActionGameLoadTest, Log, TEXT("Started load test with %d bots for %s"), Bots.Num(), InDuration > 0.f ? *FString::Printf(TEXT("%.0f seconds"), InDuration) : TEXT("an unlimited time"));
+}
+
+void ULoadTestSubsystem::StopLoadTest()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	for (FLoadTestBot& Bot : Bots)
+	{
+		if (AActionGameCharacter* Character = Bot.Character.Get())
+		{
+			AController* Controller = Character->GetController();
+			Character->Destroy();
+
+			if (Controller)
+			{
+				Controller->Destroy();
+			}
+		}
+	}
+
+	Bots.Reset();
+	bRunning = false;
+
+#if CSV_PROFILER
+	if (bStartedCsvCapture && FCsvProfiler::Get())
+	{
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+	bStartedCsvCapture = false;
+
+	UE_LOG(LogActionGameLoadTest, Log, TEXT("Stopped load test"));
+}
+
+AActionGameCharacter* ULoadTestSubsystem::SpawnBot(int32 InBotIndex)
+{
+	UWorld* World = GetWorld();
+	const AGameModeBase* GameMode = World->GetAuthGameMode();
+	UClass* PawnClass = GameMode ? GameMode->DefaultPawnClass.Get() : nullptr;
+
+	if (!PawnClass || !PawnClass->IsChildOf(AActionGameCharacter::StaticClass()))
+	{
+		UE_LOG(LogActionGameLoadTest, Warning, TEXT("The game mode's default pawn is not an ActionGameCharacter, no bots spawned"));
+		return nullptr;
+	}
+
+	FVector Origin = FVector::ZeroVector;
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Origin = It->GetActorLocation();
+		break;
+	}
+
+	// Rings of bots around the first player start, far enough apart not to spawn into each other.
+	const int32 BotsPerRing = 12;
+	const float Radius = 300.f * (1 + InBotIndex / BotsPerRing);
+	const float Angle = 360.f * (InBotIndex % BotsPerRing) / BotsPerRing;
+	const FVector Location = Origin + FRotator(0.f, Angle, 0.f).Vector() * Radius;
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AActionGameCharacter* Character = World->SpawnActor<AActionGameCharacter>(PawnClass, Location, FRotator(0.f, Angle, 0.f), SpawnParameters);
+	if (Character)
+	{
+		Character->SpawnDefaultController();
+	}
+
+	return Character;
+}
+
+void ULoadTestSubsystem::Tick(float DeltaTime)
+{
+	for (FLoadTestBot& Bot : Bots)
+	{
+		if (Bot.Character.IsValid())
+		{
+			TickBot(Bot, DeltaTime);
+		}
+	}
+
+	CSV_CUSTOM_STAT(ActionGameLoadTest, Bots, Bots.Num(), ECsvCustomStatOp::Set);
+	RecordNetStats();
+
+	if (TimeLeft > 0.f)
+	{
+		TimeLeft -= DeltaTime;
+		if (TimeLeft <= 0.f)
+		{
+			StopLoadTest();
+
+			if (bExitWhenDone)
+			{
+				FPlatformMisc::RequestExit(false);
+			}
+		}
+	}
+}
+
+void ULoadTestSubsystem::TickBot(FLoadTestBot& InBot, float DeltaTime)
+{
+	AActionGameCharacter* Character = InBot.Character.Get();
+
+	switch (InBot.Phase)
+	{
+	case ELoadTestBotPhase::Move:
+	case ELoadTestBotPhase::Sprint:
+	case ELoadTestBotPhase::Traverse:
+	case ELoadTestBotPhase::Fire:
+		Character->AddMovementInput(InBot.MoveDirection, 1.f);
+		break;
+	case ELoadTestBotPhase::DropAndPickup:
+		// Walk back over the dropped item to pick it up again.
+		Character->AddMovementInput(-InBot.MoveDirection, 1.f);
+		break;
+	default:
+		break;
+	}
+
+	InBot.PhaseTimeLeft -= DeltaTime;
+	if (InBot.PhaseTimeLeft <= 0.f)
+	{
+		LeavePhase(InBot);
+
+		const int32 NextPhase = (static_cast<int32>(InBot.Phase) + 1) % static_cast<int32>(ELoadTestBotPhase::Num);
+		EnterPhase(InBot, static_cast<ELoadTestBotPhase>(NextPhase));
+	}
+}
+
+void ULoadTestSubsystem::EnterPhase(FLoadTestBot& InBot, ELoadTestBotPhase InPhase)
+{
+	InBot.Phase = InPhase;
+	InBot.PhaseTimeLeft = LoadTestPhaseDurations[static_cast<int32>(InPhase)];
+
+	AActionGameCharacter* Character = InBot.Character.Get();
+	UAbilitySystemComponent* AbilitySystemComponent = Character ? Character->GetAbilitySystemComponent() : nullptr;
+	if (!AbilitySystemComponent)
+	{
+		return;
+	}
+
+	FGameplayEventData EventPayload;
+
+	switch (InPhase)
+	{
+	case ELoadTestBotPhase::Move:
+		InBot.MoveDirection = FRotator(0.f, FMath::FRandRange(0.f, 360.f), 0.f).Vector();
+		break;
+	case ELoadTestBotPhase::Sprint:
+		AbilitySystemComponent->TryActivateAbilitiesByTag(Character->SprintTags, true);
+		break;
+	case ELoadTestBotPhase::Traverse:
+		// Vaults when there is something to vault over, jumps otherwise.
+		Character->GetAGCharacterMovement()->TryTraversal(AbilitySystemComponent);
+		break;
+	case ELoadTestBotPhase::Fire:
+		EventPayload.EventTag = UInventoryComponent::EquipNextTag;
+		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(Character, UInventoryComponent::EquipNextTag, EventPayload);
+
+		EventPayload.EventTag = Character->AttackStartedEventTag;
+		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(Character, Character->AttackStartedEventTag, EventPayload);
+		break;
+	case ELoadTestBotPhase::DropAndPickup:
+		EventPayload.EventTag = UInventoryComponent::DropItemTag;
+		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(Character, UInventoryComponent::DropItemTag, EventPayload);
+		break;
+	default:
+		break;
+	}
+}
+
+void ULoadTestSubsystem::LeavePhase(FLoadTestBot& InBot)
+{
+	AActionGameCharacter* Character = InBot.Character.Get();
+	UAbilitySystemComponent* AbilitySystemComponent = Character ? Character->GetAbilitySystemComponent() : nullptr;
+	if (!AbilitySystemComponent)
+	{
+		return;
+	}
+
+	if (InBot.Phase == ELoadTestBotPhase::Sprint)
+	{
+		AbilitySystemComponent->CancelAbilities(&Character->SprintTags);
+	}
+	else if (InBot.Phase == ELoadTestBotPhase::Fire)
+	{
+		FGameplayEventData EventPayload;
+		EventPayload.EventTag = Character->AttackEndedEventTag;
+		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(Character, Character->AttackEndedEventTag, EventPayload);
+	}
+}
+
+void ULoadTestSubsystem::RecordNetStats() const
+{
+#if CSV_PROFILER
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!NetDriver)
+	{
+		return;
+	}
+
+	CSV_CUSTOM_STAT(ActionGameLoadTest, NetOutBytesPerSecond, NetDriver->OutBytesPerSecond, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ActionGameLoadTest, NetConnections, NetDriver->ClientConnections.Num(), ECsvCustomStatOp::Set);
+
+	// Keyed by connection id, array positions shift as clients join and leave.
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (Connection)
+		{
+			const FName StatName(*FString::Printf(TEXT("Connection%u_OutBytesPerSecond"), Connection->GetConnectionId()));
+			FCsvProfiler::RecordCustomStat(StatName, CSV_CATEGORY_INDEX(ActionGameLoadTest), Connection->OutBytesPerSecond, ECsvCustomStatOp::Set);
+		}
+	}
+#endif
+}
+
+bool ULoadTestSubsystem::IsTickable() const
+{
+	return bRunning;
+}
+
+TStatId ULoadTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULoadTestSubsystem, STATGROUP_Tickables);
+}
+
+bool ULoadTestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LoadTestSubsystem.generated.h"
+
+class AActionGameCharacter;
+
+enum class ELoadTestBotPhase : uint8
+{
+	Move,
+	Sprint,
+	Traverse,
+	Fire,
+	DropAndPickup,
+	Num
+};
+
+struct FLoadTestBot
+{
+	TWeakObjectPtr<AActionGameCharacter> Character;
+
+	ELoadTestBotPhase Phase = ELoadTestBotPhase::Move;
+
+	float PhaseTimeLeft = 0.f;
+
+	FVector MoveDirection = FVector::ForwardVector;
+};
+
+/**
+ * Server side load test driver. Spawns AI possessed characters and loops them through moving, sprinting, traversal,
+ * firing and dropping then picking up their items while recording frame and net stats to the CSV profiler.
+ * Started with "LoadTest.Start <Bots> [Seconds]" or "-LoadTestBots=<Bots> [-LoadTestSeconds=<Seconds>]" on the command
+ * line, in which case the process exits once the run is over. Not available in shipping builds.
+ * Bots are AI controlled and replicate to whatever clients are connected, per connection bytes are only recorded for
+ * clients connected from outside, e.g. game instances started with the server address.
+ */
+UCLASS()
+class ACTIONGAME_API ULoadTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	void StartLoadTest(int32 InNumBots, float InDuration);
+
+	void StopLoadTest();
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	AActionGameCharacter* SpawnBot(int32 InBotIndex);
+
+	void TickBot(FLoadTestBot& InBot, float DeltaTime);
+
+	void EnterPhase(FLoadTestBot& InBot, ELoadTestBotPhase InPhase);
+
+	void LeavePhase(FLoadTestBot& InBot);
+
+	void RecordNetStats() const;
+
+	TArray<FLoadTestBot> Bots;
+
+	float TimeLeft = 0.f;
+
+	bool bRunning = false;
+
+	bool bExitWhenDone = false;
+
+	bool bStartedCsvCapture = false;
+};
\ No newline at end of file
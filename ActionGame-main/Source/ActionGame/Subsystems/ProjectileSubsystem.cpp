@@ -0,0 +1,335 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ProjectileSubsystem.h"
+
+#include "Actors/ProjectileReplicator.h"
+#include "ActionGameStatics.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/WorldSettings.h"
+#include "Kismet/GameplayStatics.h"
+#include "DrawDebugHelpers.h"
+#include "NiagaraFunctionLibrary.h"
+#include "ActionGameStats.h"
+#include "ActionGameQueries.h"
+
+DECLARE_CYCLE_STAT(TEXT("ProjectileSubsystem Tick"), STAT_ProjectileSubsystemTick, STATGROUP_ActionGame);
+
+static TAutoConsoleVariable<float> CVarProjectileMaxLifetime(
+	TEXT("ProjectileMaxLifetime"),
+	10.f,
+	TEXT("Projectiles that haven't hit anything after this many seconds are removed without stopping"),
+	ECVF_Default
+);
+
+static const FName ProjectileCollisionProfileName = TEXT("Projectile");
+
+int32 UProjectileSubsystem::LaunchProjectile(TSubclassOf<UProjectileStaticData> ProjectileDataClass, const FVector& Origin, const FVector& Direction, AActor* Owner, APawn* Instigator)
+{
+	UWorld* World = GetWorld();
+
+	const UProjectileStaticData* ProjectileData = IsValid(ProjectileDataClass) ? GetDefault<UProjectileStaticData>(ProjectileDataClass) : nullptr;
+
+	if (!World || !ProjectileData)
+	{
+		return INDEX_NONE;
+	}
+
+	if (!Replicator)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		Replicator = World->SpawnActor<AProjectileReplicator>(AProjectileReplicator::StaticClass(), FTransform::Identity, SpawnParameters);
+	}
+
+	const float Speed = ProjectileData->MaxSpeed > 0.f ? FMath::Min(ProjectileData->InitialSpeed, ProjectileData->MaxSpeed) : ProjectileData->InitialSpeed;
+
+	// Snap to what FVector_NetQuantize sends so server and clients simulate the same path.
+	const FVector SnappedOrigin = Origin.GridSnap(1.f);
+	const FVector SnappedVelocity = (Direction.GetSafeNormal() * Speed).GridSnap(1.f);
+
+	const int32 ProjectileId = NextProjectileId++;
+
+	AddProjectile(ProjectileId, ProjectileDataClass, SnappedOrigin, SnappedVelocity, 0.f, Owner, Instigator);
+
+	if (Replicator)
+	{
+		FProjectileSpawnItem SpawnItem;
+		SpawnItem.ProjectileId = ProjectileId;
+		SpawnItem.ProjectileDataClass = ProjectileDataClass;
+		SpawnItem.Origin = SnappedOrigin;
+		SpawnItem.Velocity = SnappedVelocity;
+		SpawnItem.ServerSpawnTime = GetServerWorldTimeSeconds();
+		SpawnItem.Instigator = Instigator;
+
+		Replicator->AddSpawn(SpawnItem);
+	}
+
+	return ProjectileId;
+}
+
+void UProjectileSubsystem::AddSimulatedProjectile(const FProjectileSpawnItem& InSpawnItem)
+{
+	if (ProjectileIds.Contains(InSpawnItem.ProjectileId))
+	{
+		return;
+	}
+
+	// Catch up with the server, late joiners and lagging clients start the projectile where it is now.
+	const float Age = FMath::Max(0.f, GetServerWorldTimeSeconds() - InSpawnItem.ServerSpawnTime);
+
+	AddProjectile(InSpawnItem.ProjectileId, InSpawnItem.ProjectileDataClass, InSpawnItem.Origin, InSpawnItem.Velocity, Age, nullptr, InSpawnItem.Instigator);
+}
+
+void UProjectileSubsystem::StopSimulatedProjectile(int32 InProjectileId)
+{
+	const int32 Index = ProjectileIds.Find(InProjectileId);
+
+	if (Index != INDEX_NONE)
+	{
+		PlayStopEffects(ProjectileDataDefaults[Index], Locations[Index]);
+
+		RemoveProjectileAt(Index);
+	}
+}
+
+void UProjectileSubsystem::AddProjectile(int32 InProjectileId, TSubclassOf<UProjectileStaticData> ProjectileDataClass, const FVector& Origin, const FVector& Velocity, float Age, AActor* Owner, APawn* Instigator)
+{
+	const UProjectileStaticData* ProjectileData = IsValid(ProjectileDataClass) ? GetDefault<UProjectileStaticData>(ProjectileDataClass) : nullptr;
+
+	if (!ProjectileData)
+	{
+		return;
+	}
+
+	const float GravityZ = GetWorld()->GetGravityZ() * ProjectileData->GravityMultiplayer;
+
+	ProjectileIds.Add(InProjectileId);
+	ProjectileDataDefaults.Add(ProjectileData);
+	Origins.Add(Origin);
+	InitialVelocities.Add(Velocity);
+	GravityZs.Add(GravityZ);
+	Ages.Add(Age);
+	Locations.Add(Origin + Velocity * Age + FVector(0.f, 0.f, 0.5f * GravityZ * Age * Age));
+	CollisionRadii.Add(ProjectileData->StaticMesh ? ProjectileData->StaticMesh->GetBounds().SphereRadius : 1.f);
+	Owners.Add(Owner);
+	Instigators.Add(Instigator);
+
+	if (ActionGameQueries::ShouldDrawDebug(CVarShowProjectiles))
+	{
+		DebugDrawPath(ProjectileData, Origin, Velocity);
+	}
+}
+
+void UProjectileSubsystem::RemoveProjectileAt(int32 Index)
+{
+	ProjectileIds.RemoveAtSwap(Index, 1, false);
+	ProjectileDataDefaults.RemoveAtSwap(Index, 1, false);
+	Origins.RemoveAtSwap(Index, 1, false);
+	InitialVelocities.RemoveAtSwap(Index, 1, false);
+	GravityZs.RemoveAtSwap(Index, 1, false);
+	Ages.RemoveAtSwap(Index, 1, false);
+	Locations.RemoveAtSwap(Index, 1, false);
+	CollisionRadii.RemoveAtSwap(Index, 1, false);
+	Owners.RemoveAtSwap(Index, 1, false);
+	Instigators.RemoveAtSwap(Index, 1, false);
+}
+
+void UProjectileSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileSubsystemTick);
+	CSV_SCOPED_TIMING_STAT(ActionGame, ProjectileSubsystemTick);
+
+	Super::Tick(DeltaTime);
+
+	UWorld* World = GetWorld();
+
+	if (ProjectileIds.Num() > 0)
+	{
+		const float MaxLifetime = CVarProjectileMaxLifetime.GetValueOnGameThread();
+		const float KillZ = World->GetWorldSettings() ? World->GetWorldSettings()->KillZ : -UE_BIG_NUMBER;
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileSweep), false);
+
+		// Walk backwards so stopped projectiles can be swapped out in place.
+		for (int32 Index = ProjectileIds.Num() - 1; Index >= 0; --Index)
+		{
+			const float Age = Ages[Index] + DeltaTime;
+			const FVector NewLocation = Origins[Index] + InitialVelocities[Index] * Age + FVector(0.f, 0.f, 0.5f * GravityZs[Index] * Age * Age);
+
+			QueryParams.ClearIgnoredActors();
+
+			if (const APawn* Instigator = Instigators[Index].Get())
+			{
+				QueryParams.AddIgnoredActor(Instigator);
+			}
+
+			FHitResult HitResult;
+
+			ACTIONGAME_COUNT_TRACES(1);
+			if (World->SweepSingleByProfile(HitResult, Locations[Index], NewLocation, FQuat::Identity, ProjectileCollisionProfileName, FCollisionShape::MakeSphere(CollisionRadii[Index]), QueryParams))
+			{
+				OnProjectileStop(Index, HitResult);
+				continue;
+			}
+
+			Ages[Index] = Age;
+			Locations[Index] = NewLocation;
+
+			if (NewLocation.Z < KillZ || (MaxLifetime > 0.f && Age > MaxLifetime))
+			{
+				// Drop the spawn record too, otherwise it stays in the always relevant list and late joiners replay it.
+				if (Replicator && World->GetNetMode() != NM_Client)
+				{
+					Replicator->RemoveSpawn(ProjectileIds[Index]);
+				}
+
+				RemoveProjectileAt(Index);
+			}
+		}
+	}
+
+	if (World->GetNetMode() != NM_DedicatedServer)
+	{
+		UpdateMeshInstances();
+	}
+}
+
+void UProjectileSubsystem::OnProjectileStop(int32 Index, const FHitResult& ImpactResult)
+{
+	const UProjectileStaticData* ProjectileData = ProjectileDataDefaults[Index];
+	const FVector StopLocation = ImpactResult.Location;
+
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		UActionGameStatics::ApplyRadialDamage(this, Owners[Index].Get(), StopLocation,
+		ProjectileData->DamageRadius,
+		ProjectileData->BaseDamage,
+		ProjectileData->Effects,
+		ProjectileData->RadialDamageQueryTypes,
+		ProjectileData->RadialDamageTraceType);
+
+		if (Replicator)
+		{
+			Replicator->RemoveSpawn(ProjectileIds[Index]);
+		}
+	}
+
+	PlayStopEffects(ProjectileData, StopLocation);
+
+	RemoveProjectileAt(Index);
+}
+
+void UProjectileSubsystem::PlayStopEffects(const UProjectileStaticData* ProjectileData, const FVector& Location)
+{
+	if (ProjectileData && GetWorld()->GetNetMode() != NM_DedicatedServer)
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, ProjectileData->OnStopSFX, Location, 1.f);
+
+		UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, ProjectileData->OnStopVFX, Location);
+	}
+}
+
+void UProjectileSubsystem::UpdateMeshInstances()
+{
+	for (auto& MeshBatch : MeshBatches)
+	{
+		MeshBatch.Value.Transforms.Reset();
+	}
+
+	for (int32 Index = 0; Index < ProjectileIds.Num(); ++Index)
+	{
+		UStaticMesh* StaticMesh = ProjectileDataDefaults[Index]->StaticMesh;
+
+		if (!StaticMesh)
+		{
+			continue;
+		}
+
+		FProjectileMeshBatch* MeshBatch = MeshBatches.Find(StaticMesh);
+
+		if (!MeshBatch)
+		{
+			if (!Replicator)
+			{
+				continue;
+			}
+
+			UInstancedStaticMeshComponent* InstancedMesh = NewObject<UInstancedStaticMeshComponent>(Replicator);
+			InstancedMesh->SetStaticMesh(StaticMesh);
+			InstancedMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			InstancedMesh->bReceivesDecals = false;
+			InstancedMesh->SetupAttachment(Replicator->GetRootComponent());
+			InstancedMesh->RegisterComponent();
+
+			MeshBatch = &MeshBatches.Add(StaticMesh);
+			MeshBatch->InstancedMesh = InstancedMesh;
+		}
+
+		const float Age = Ages[Index];
+		const FVector Velocity = InitialVelocities[Index] + FVector(0.f, 0.f, GravityZs[Index] * Age);
+
+		MeshBatch->Transforms.Emplace(Velocity.Rotation(), Locations[Index]);
+	}
+
+	for (auto& MeshBatch : MeshBatches)
+	{
+		UInstancedStaticMeshComponent* InstancedMesh = MeshBatch.Value.InstancedMesh;
+		const TArray<FTransform>& Transforms = MeshBatch.Value.Transforms;
+
+		if (!IsValid(InstancedMesh))
+		{
+			continue;
+		}
+
+		if (InstancedMesh->GetInstanceCount() != Transforms.Num())
+		{
+			InstancedMesh->ClearInstances();
+			InstancedMesh->AddInstances(Transforms, false, true);
+		}
+		else if (Transforms.Num() > 0)
+		{
+			InstancedMesh->BatchUpdateInstancesTransforms(0, Transforms, true, true);
+		}
+	}
+}
+
+void UProjectileSubsystem::DebugDrawPath(const UProjectileStaticData* ProjectileData, const FVector& Origin, const FVector& Velocity) const
+{
+	FPredictProjectilePathParams PredictProjectilePathParams;
+	PredictProjectilePathParams.StartLocation = Origin;
+	PredictProjectilePathParams.LaunchVelocity = Velocity;
+	PredictProjectilePathParams.TraceChannel = ECollisionChannel::ECC_Visibility;
+	PredictProjectilePathParams.bTraceComplex = true;
+	PredictProjectilePathParams.bTraceWithCollision = true;
+	PredictProjectilePathParams.DrawDebugType = EDrawDebugTrace::ForDuration;
+	PredictProjectilePathParams.DrawDebugTime = 3.f;
+	PredictProjectilePathParams.OverrideGravityZ = ProjectileData->GravityMultiplayer == 0.f ? 0.0001f : ProjectileData->GravityMultiplayer;
+
+	FPredictProjectilePathResult PredictProjectilePathResult;
+	if (UGameplayStatics::PredictProjectilePath(GetWorld(), PredictProjectilePathParams, PredictProjectilePathResult))
+	{
+		DrawDebugSphere(GetWorld(), PredictProjectilePathResult.HitResult.Location, 50, 10, FColor::Red);
+	}
+}
+
+float UProjectileSubsystem::GetServerWorldTimeSeconds() const
+{
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+
+	return GameState ? GameState->GetServerWorldTimeSeconds() : (World ? World->GetTimeSeconds() : 0.f);
+}
+
+TStatId UProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileSubsystem, STATGROUP_Tickables);
+}
+
+bool UProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActionGameTypes.h"
+#include "ProjectileSubsystem.generated.h"
+
+class AProjectileReplicator;
+class UInstancedStaticMeshComponent;
+struct FProjectileSpawnItem;
+
+USTRUCT()
+struct FProjectileMeshBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UInstancedStaticMeshComponent* InstancedMesh = nullptr;
+
+	TArray<FTransform> Transforms;
+};
+
+/**
+ * Simulates every live projectile of the world without a per projectile actor. The server launches projectiles
+ * and replicates their spawn parameters through AProjectileReplicator, clients run the same ballistic path from
+ * those parameters and draw them with one instanced mesh per projectile mesh.
+ */
+UCLASS()
+class ACTIONGAME_API UProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// Server only. Returns the id of the new projectile.
+	int32 LaunchProjectile(TSubclassOf<UProjectileStaticData> ProjectileDataClass, const FVector& Origin, const FVector& Direction, AActor* Owner, APawn* Instigator);
+
+	// Client side, called when the spawn parameters of a projectile replicate in.
+	void AddSimulatedProjectile(const FProjectileSpawnItem& InSpawnItem);
+
+	// Client side, called when the server stopped a projectile. No-op if it already stopped locally.
+	void StopSimulatedProjectile(int32 InProjectileId);
+
+	void SetReplicator(AProjectileReplicator* InReplicator) {Replicator = InReplicator;}
+
+	AProjectileReplicator* GetReplicator() const {return Replicator;}
+
+	int32 GetNumProjectiles() const {return ProjectileIds.Num();}
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	void AddProjectile(int32 InProjectileId, TSubclassOf<UProjectileStaticData> ProjectileDataClass, const FVector& Origin, const FVector& Velocity, float Age, AActor* Owner, APawn* Instigator);
+
+	void RemoveProjectileAt(int32 Index);
+
+	void OnProjectileStop(int32 Index, const FHitResult& ImpactResult);
+
+	void PlayStopEffects(const UProjectileStaticData* ProjectileData, const FVector& Location);
+
+	void UpdateMeshInstances();
+
+	void DebugDrawPath(const UProjectileStaticData* ProjectileData, const FVector& Origin, const FVector& Velocity) const;
+
+	float GetServerWorldTimeSeconds() const;
+
+	UPROPERTY()
+	AProjectileReplicator* Replicator = nullptr;
+
+	int32 NextProjectileId = 0;
+
+	// Structure of arrays, one entry per live projectile. Removal swaps with the last entry in every array.
+	TArray<int32> ProjectileIds;
+
+	TArray<const UProjectileStaticData*> ProjectileDataDefaults;
+
+	TArray<FVector> Origins;
+
+	TArray<FVector> InitialVelocities;
+
+	TArray<float> GravityZs;
+
+	TArray<float> Ages;
+
+	TArray<FVector> Locations;
+
+	TArray<float> CollisionRadii;
+
+	TArray<TWeakObjectPtr<AActor>> Owners;
+
+	TArray<TWeakObjectPtr<APawn>> Instigators;
+
+	UPROPERTY()
+	TMap<UStaticMesh*, FProjectileMeshBatch> MeshBatches;
+};
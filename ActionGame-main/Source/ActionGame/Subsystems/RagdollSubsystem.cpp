@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/RagdollSubsystem.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "ActionGameStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("RagdollSubsystem Tick"), STAT_RagdollSubsystemTick, STATGROUP_ActionGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulated Ragdolls"), STAT_SimulatedRagdolls, STATGROUP_ActionGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Awake Ragdolls"), STAT_AwakeRagdolls, STATGROUP_ActionGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Awake Ragdoll Bodies"), STAT_AwakeRagdollBodies, STATGROUP_ActionGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Frozen Ragdolls"), STAT_FrozenRagdolls, STATGROUP_ActionGame);
+
+static TAutoConsoleVariable<int32> CVarRagdollMaxSimulated(
+	TEXT("RagdollMaxSimulated"),
+	8,
+	TEXT("Max ragdolls simulated at once, the oldest one is frozen in its current pose when a new one starts"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRagdollSettleSpeed(
+	TEXT("RagdollSettleSpeed"),
+	5.f,
+	TEXT("A ragdoll whose root body moves slower than this is settling"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRagdollSettleTime(
+	TEXT("RagdollSettleTime"),
+	0.5f,
+	TEXT("Seconds a ragdoll has to stay settled before it is put to sleep"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRagdollMaxAwakeTime(
+	TEXT("RagdollMaxAwakeTime"),
+	8.f,
+	TEXT("Ragdolls are put to sleep after simulating this long even if they never settle"),
+	ECVF_Default);
+
+bool URagdollSubsystem::StartRagdoll(USkeletalMeshComponent* InMesh)
+{
+	// Nobody sees a ragdoll on a dedicated server.
+	if (!InMesh || InMesh->IsSimulatingPhysics() || GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		return false;
+	}
+
+	const int32 MaxSimulated = CVarRagdollMaxSimulated.GetValueOnGameThread();
+	if (MaxSimulated <= 0)
+	{
+		return false;
+	}
+
+	while (ActiveRagdolls.Num() >= MaxSimulated)
+	{
+		FreezeRagdoll(ActiveRagdolls[0].Mesh.Get());
+		ActiveRagdolls.RemoveAt(0, 1, false);
+	}
+
+	InMesh->SetCollisionProfileName(TEXT("Ragdoll"));
+	InMesh->SetSimulatePhysics(true);
+	InMesh->SetAllPhysicsLinearVelocity(FVector::ZeroVector);
+	InMesh->SetAllPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+	InMesh->WakeAllRigidBodies();
+
+	FActiveRagdoll& Ragdoll = ActiveRagdolls.AddDefaulted_GetRef();
+	Ragdoll.Mesh = InMesh;
+	Ragdoll.StartTime = GetWorld()->GetTimeSeconds();
+
+	return true;
+}
+
+void URagdollSubsystem::FreezeRagdoll(USkeletalMeshComponent* InMesh)
+{
+	if (!InMesh)
+	{
+		return;
+	}
+
+	// Keep the last simulated pose instead of snapping back to the animated one, then take the bodies out of the scene.
+	InMesh->bNoSkeletonUpdate = true;
+	InMesh->SetComponentTickEnabled(false);
+	InMesh->SetSimulatePhysics(false);
+	InMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	FrozenRagdolls.Add(InMesh);
+}
+
+void URagdollSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RagdollSubsystemTick);
+	CSV_SCOPED_TIMING_STAT(ActionGame, RagdollSubsystemTick);
+
+	ActiveRagdolls.RemoveAll([](const FActiveRagdoll& Ragdoll) { return !Ragdoll.Mesh.IsValid() || !Ragdoll.Mesh->IsSimulatingPhysics(); });
+	FrozenRagdolls.RemoveAll([](const TWeakObjectPtr<USkeletalMeshComponent>& Mesh) { return !Mesh.IsValid(); });
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	const float SettleSpeedSquared = FMath::Square(CVarRagdollSettleSpeed.GetValueOnGameThread());
+	const float SettleTime = CVarRagdollSettleTime.GetValueOnGameThread();
+	const float MaxAwakeTime = CVarRagdollMaxAwakeTime.GetValueOnGameThread();
+
+	for (FActiveRagdoll& Ragdoll : ActiveRagdolls)
+	{
+		USkeletalMeshComponent* Mesh = Ragdoll.Mesh.Get();
+
+		if (Ragdoll.bAsleep)
+		{
+			// Something hit it, let it settle again.
+			if (Mesh->IsAnyRigidBodyAwake())
+			{
+				Ragdoll.bAsleep = false;
+				Ragdoll.SettledTime = 0.f;
+				Ragdoll.StartTime = Now;
+			}
+
+			continue;
+		}
+
+		if (Mesh->GetPhysicsLinearVelocity().SizeSquared() <= SettleSpeedSquared)
+		{
+			Ragdoll.SettledTime += DeltaTime;
+		}
+		else
+		{
+			Ragdoll.SettledTime = 0.f;
+		}
+
+		if (Ragdoll.SettledTime >= SettleTime || Now - Ragdoll.StartTime >= MaxAwakeTime)
+		{
+			Mesh->PutAllRigidBodiesToSleep();
+			Ragdoll.bAsleep = true;
+		}
+	}
+
+	ReportStats();
+}
+
+void URagdollSubsystem::ReportStats() const
+{
+	int32 NumAwake = 0;
+	int32 NumAwakeBodies = 0;
+
+	for (const FActiveRagdoll& Ragdoll : ActiveRagdolls)
+	{
+		if (!Ragdoll.bAsleep)
+		{
+			++NumAwake;
+			NumAwakeBodies += Ragdoll.Mesh->Bodies.Num();
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SimulatedRagdolls, ActiveRagdolls.Num());
+	SET_DWORD_STAT(STAT_AwakeRagdolls, NumAwake);
+	SET_DWORD_STAT(STAT_AwakeRagdollBodies, NumAwakeBodies);
+	SET_DWORD_STAT(STAT_FrozenRagdolls, FrozenRagdolls.Num());
+
+	CSV_CUSTOM_STAT(ActionGame, SimulatedRagdolls, ActiveRagdolls.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ActionGame, AwakeRagdollBodies, NumAwakeBodies, ECsvCustomStatOp::Set);
+}
+
+TStatId URagdollSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URagdollSubsystem, STATGROUP_Tickables);
+}
+
+bool URagdollSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RagdollSubsystem.generated.h"
+
+class USkeletalMeshComponent;
+
+struct FActiveRagdoll
+{
+	TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+
+	float StartTime = 0.f;
+
+	// How long the ragdoll has been below the settle speed.
+	float SettledTime = 0.f;
+
+	bool bAsleep = false;
+};
+
+/**
+ * Budgets the ragdolls of the world. Nothing is simulated on a dedicated server, ragdolls are put to sleep once they
+ * settle, and past RagdollMaxSimulated the oldest ragdoll is frozen in its current pose and leaves the physics scene.
+ */
+UCLASS()
+class ACTIONGAME_API URagdollSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// Returns false when the mesh was not turned into a ragdoll, e.g. on a dedicated server.
+	bool StartRagdoll(USkeletalMeshComponent* InMesh);
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	void FreezeRagdoll(USkeletalMeshComponent* InMesh);
+
+	void ReportStats() const;
+
+	// Simulated ragdolls, oldest first.
+	TArray<FActiveRagdoll> ActiveRagdolls;
+
+	TArray<TWeakObjectPtr<USkeletalMeshComponent>> FrozenRagdolls;
+};
\ No newline at end of file
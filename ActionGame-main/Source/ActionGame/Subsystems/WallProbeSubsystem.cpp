@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WallProbeSubsystem.h"
+
+#include "ActorComponents/AG_CharacterMovementComponent.h"
+
+static TAutoConsoleVariable<int32> CVarMaxDeferredWallProbes(
+	TEXT("MaxDeferredWallProbesPerFrame"),
+	4,
+	TEXT("Max number of wall sweeps per frame for characters that are not climbing, trying to climb or airborne"),
+	ECVF_Default
+);
+
+void UWallProbeSubsystem::RegisterMovementComponent(UAG_CharacterMovementComponent* InMovementComponent)
+{
+	MovementComponents.AddUnique(InMovementComponent);
+}
+
+void UWallProbeSubsystem::UnregisterMovementComponent(UAG_CharacterMovementComponent* InMovementComponent)
+{
+	MovementComponents.Remove(InMovementComponent);
+}
+
+void UWallProbeSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const int32 NumComponents = MovementComponents.Num();
+
+	if (NumComponents == 0)
+	{
+		return;
+	}
+
+	const int32 MaxDeferredProbes = FMath::Max(0, CVarMaxDeferredWallProbes.GetValueOnGameThread());
+
+	const int32 StartIndex = NextDeferredIndex % NumComponents;
+
+	int32 DeferredProbes = 0;
+
+	for (int32 Offset = 0; Offset < NumComponents; ++Offset)
+	{
+		const int32 Index = (StartIndex + Offset) % NumComponents;
+
+		UAG_CharacterMovementComponent* MovementComponent = MovementComponents[Index];
+
+		if (!IsValid(MovementComponent))
+		{
+			continue;
+		}
+
+		switch (MovementComponent->GetWallProbePriority())
+		{
+		case EWallProbePriority::Immediate:
+			MovementComponent->SweepAndStoreWallHits();
+			break;
+		case EWallProbePriority::Deferred:
+			if (DeferredProbes < MaxDeferredProbes)
+			{
+				MovementComponent->SweepAndStoreWallHits();
+				NextDeferredIndex = Index + 1;
+				++DeferredProbes;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+TStatId UWallProbeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWallProbeSubsystem, STATGROUP_Tickables);
+}
+
+bool UWallProbeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
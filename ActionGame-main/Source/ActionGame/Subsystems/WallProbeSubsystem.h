@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WallProbeSubsystem.generated.h"
+
+class UAG_CharacterMovementComponent;
+
+enum class EWallProbePriority : uint8
+{
+	// Nothing reads the wall hits of this character (e.g. simulated proxies).
+	None,
+	// Probed round-robin under the per-frame budget.
+	Deferred,
+	// Probed every frame (climbing, wanting to climb or airborne).
+	Immediate
+};
+
+/**
+ * Runs the climbing wall sweeps of all character movement components, so that only characters that can
+ * actually start or continue climbing pay for a sweep every frame.
+ */
+UCLASS()
+class ACTIONGAME_API UWallProbeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	void RegisterMovementComponent(UAG_CharacterMovementComponent* InMovementComponent);
+
+	void UnregisterMovementComponent(UAG_CharacterMovementComponent* InMovementComponent);
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	UPROPERTY()
+	TArray<UAG_CharacterMovementComponent*> MovementComponents;
+
+	int32 NextDeferredIndex = 0;
+};
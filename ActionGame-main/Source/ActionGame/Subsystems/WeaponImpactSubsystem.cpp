@@ -0,0 +1,240 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WeaponImpactSubsystem.h"
+
+#include "Inventory/ItemActors/WeaponItemActor.h"
+#include "PlayerControllers/ActionGamePlayerController.h"
+#include "PhysicalMaterials/AG_PhysicalMaterial.h"
+#include "ActionGameTypes.h"
+#include "Kismet/GameplayStatics.h"
+#include "NiagaraFunctionLibrary.h"
+#include "Engine/World.h"
+#include "ActionGameStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Flush Weapon Impacts"), STAT_FlushWeaponImpacts, STATGROUP_ActionGame);
+
+DEFINE_LOG_CATEGORY_STATIC(LogActionGameWeaponImpact, Log, All);
+
+static TAutoConsoleVariable<float> CVarWeaponImpactCullDistance(
+	TEXT("WeaponImpactCullDistance"),
+	6000.f,
+	TEXT("Weapon impacts further than this from both a connection's view point and the firing weapon are not sent to it"),
+	ECVF_Default);
+
+static uint8 QuantizeOctahedralComponent(float InValue)
+{
+	return static_cast<uint8>(FMath::RoundToInt((FMath::Clamp(InValue, -1.f, 1.f) * 0.5f + 0.5f) * 255.f));
+}
+
+static float DequantizeOctahedralComponent(uint8 InValue)
+{
+	return InValue / 255.f * 2.f - 1.f;
+}
+
+void FWeaponImpact::SetNormal(const FVector& InNormal)
+{
+	const FVector Normal = InNormal.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+	const float L1Norm = FMath::Abs(Normal.X) + FMath::Abs(Normal.Y) + FMath::Abs(Normal.Z);
+
+	float X = Normal.X / L1Norm;
+	float Y = Normal.Y / L1Norm;
+
+	// Fold the lower hemisphere over the diagonals.
+	if (Normal.Z < 0.f)
+	{
+		const float FoldedX = (1.f - FMath::Abs(Y)) * (X >= 0.f ? 1.f : -1.f);
+		const float FoldedY = (1.f - FMath::Abs(X)) * (Y >= 0.f ? 1.f : -1.f);
+		X = FoldedX;
+		Y = FoldedY;
+	}
+
+	PackedNormal = static_cast<uint16>(QuantizeOctahedralComponent(X) << 8 | QuantizeOctahedralComponent(Y));
+}
+
+FVector FWeaponImpact::GetNormal() const
+{
+	FVector Normal;
+	Normal.X = DequantizeOctahedralComponent(static_cast<uint8>(PackedNormal >> 8));
+	Normal.Y = DequantizeOctahedralComponent(static_cast<uint8>(PackedNormal & 0xFF));
+	Normal.Z = 1.f - FMath::Abs(Normal.X) - FMath::Abs(Normal.Y);
+
+	const float Fold = FMath::Clamp(-Normal.Z, 0.f, 1.f);
+	Normal.X += Normal.X >= 0.f ? -Fold : Fold;
+	Normal.Y += Normal.Y >= 0.f ? -Fold : Fold;
+
+	return Normal.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+}
+
+void UWeaponImpactSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LoadImpactMaterials();
+}
+
+void UWeaponImpactSubsystem::QueueImpact(AWeaponItemActor* InWeapon, const FHitResult& InHitResult)
+{
+	FWeaponImpact Impact;
+	Impact.Location = InHitResult.ImpactPoint;
+	Impact.SetNormal(InHitResult.ImpactNormal);
+	Impact.MaterialIndex = FindImpactMaterialIndex(InHitResult.PhysMaterial.Get());
+
+	FPendingWeaponImpacts* WeaponImpacts = PendingImpacts.FindByPredicate([InWeapon](const FPendingWeaponImpacts& Pending) { return Pending.Weapon.Get() == InWeapon; });
+	if (!WeaponImpacts)
+	{
+		WeaponImpacts = &PendingImpacts.AddDefaulted_GetRef();
+		WeaponImpacts->Weapon = InWeapon;
+	}
+
+	WeaponImpacts->Impacts.Add(Impact);
+
+	// A listen server plays its own impacts right away, nothing to resolve.
+	if (GetWorld()->GetNetMode() != NM_DedicatedServer)
+	{
+		PlayImpactEffects(InWeapon, InHitResult.ImpactPoint, InHitResult.ImpactNormal, Cast<UAG_PhysicalMaterial>(InHitResult.PhysMaterial.Get()));
+	}
+}
+
+void UWeaponImpactSubsystem::Tick(float DeltaTime)
+{
+	if (PendingImpacts.Num() > 0)
+	{
+		FlushImpacts();
+	}
+}
+
+void UWeaponImpactSubsystem::FlushImpacts()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlushWeaponImpacts);
+	CSV_SCOPED_TIMING_STAT(ActionGame, FlushWeaponImpacts);
+
+	const float CullDistanceSquared = FMath::Square(CVarWeaponImpactCullDistance.GetValueOnGameThread());
+
+	TArray<FWeaponImpact> RelevantImpacts;
+
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		AActionGamePlayerController* PlayerController = Cast<AActionGamePlayerController>(Iterator->Get());
+		if (!PlayerController || PlayerController->IsLocalController())
+		{
+			continue;
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		for (const FPendingWeaponImpacts& WeaponImpacts : PendingImpacts)
+		{
+			AWeaponItemActor* Weapon = WeaponImpacts.Weapon.Get();
+			if (!Weapon)
+			{
+				continue;
+			}
+
+			// The owning client already played these when it fired.
+			const APawn* OwnerPawn = Cast<APawn>(Weapon->GetOwner());
+			if (OwnerPawn && OwnerPawn->GetController() == PlayerController)
+			{
+				continue;
+			}
+
+			const bool bWeaponInRange = FVector::DistSquared(ViewLocation, Weapon->GetActorLocation()) <= CullDistanceSquared;
+
+			RelevantImpacts.Reset();
+			for (const FWeaponImpact& Impact : WeaponImpacts.Impacts)
+			{
+				if (bWeaponInRange || FVector::DistSquared(ViewLocation, Impact.Location) <= CullDistanceSquared)
+				{
+					RelevantImpacts.Add(Impact);
+				}
+			}
+
+			if (RelevantImpacts.Num() > 0)
+			{
+				PlayerController->ClientPlayWeaponImpacts(Weapon, RelevantImpacts);
+			}
+		}
+	}
+
+	PendingImpacts.Reset();
+}
+
+void UWeaponImpactSubsystem::PlayReplicatedImpacts(AWeaponItemActor* InWeapon, const TArray<FWeaponImpact>& InImpacts)
+{
+	for (const FWeaponImpact& Impact : InImpacts)
+	{
+		PlayImpactEffects(InWeapon, Impact.Location, Impact.GetNormal(), FindImpactMaterial(Impact.MaterialIndex));
+	}
+}
+
+void UWeaponImpactSubsystem::PlayImpactEffects(AWeaponItemActor* InWeapon, const FVector& InLocation, const FVector& InNormal, const UAG_PhysicalMaterial* InPhysicalMaterial)
+{
+	if (InPhysicalMaterial)
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, InPhysicalMaterial->PointImpactSound, InLocation, 1.f);
+
+		if (InPhysicalMaterial->PointImpactVFX)
+		{
+			UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, InPhysicalMaterial->PointImpactVFX, InLocation, FRotationMatrix::MakeFromZ(InNormal).Rotator(), FVector(1.f), true, true, ENCPoolMethod::AutoRelease);
+		}
+	}
+
+	const UWeaponStaticData* WeaponData = InWeapon ? InWeapon->GetWeaponStaticData() : nullptr;
+	if (WeaponData)
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, WeaponData->AttackSound, InWeapon->GetActorLocation(), 1.f);
+	}
+}
+
+const UAG_PhysicalMaterial* UWeaponImpactSubsystem::FindImpactMaterial(uint8 InMaterialIndex) const
+{
+	return ImpactMaterials.IsValidIndex(InMaterialIndex) ? ImpactMaterials[InMaterialIndex] : nullptr;
+}
+
+uint8 UWeaponImpactSubsystem::FindImpactMaterialIndex(const UPhysicalMaterial* InPhysicalMaterial) const
+{
+	const uint8* MaterialIndex = InPhysicalMaterial ? ImpactMaterialIndices.Find(InPhysicalMaterial) : nullptr;
+
+	return MaterialIndex ? *MaterialIndex : FWeaponImpact::NoMaterialIndex;
+}
+
+void UWeaponImpactSubsystem::LoadImpactMaterials()
+{
+	ImpactMaterials.Reset();
+	ImpactMaterialIndices.Reset();
+
+	const int32 NumMaterials = FMath::Min<int32>(ImpactMaterialRegistry.Num(), FWeaponImpact::NoMaterialIndex);
+
+	if (ImpactMaterialRegistry.Num() > NumMaterials)
+	{
+		UE_LOG(LogActionGameWeaponImpact, Warning, TEXT("Only the first %d of %d impact materials can be replicated"), NumMaterials, ImpactMaterialRegistry.Num());
+	}
+
+	for (int32 Index = 0; Index < NumMaterials; ++Index)
+	{
+		// Keep missing entries as null so the indices after them still match on every machine.
+		UAG_PhysicalMaterial* PhysicalMaterial = ImpactMaterialRegistry[Index].LoadSynchronous();
+		ImpactMaterials.Add(PhysicalMaterial);
+
+		if (!PhysicalMaterial)
+		{
+			UE_LOG(LogActionGameWeaponImpact, Warning, TEXT("Impact material %s could not be loaded"), *ImpactMaterialRegistry[Index].ToString());
+		}
+		else if (!ImpactMaterialIndices.Contains(PhysicalMaterial))
+		{
+			ImpactMaterialIndices.Add(PhysicalMaterial, static_cast<uint8>(Index));
+		}
+	}
+}
+
+TStatId UWeaponImpactSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWeaponImpactSubsystem, STATGROUP_Tickables);
+}
+
+bool UWeaponImpactSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
\ No newline at end of file
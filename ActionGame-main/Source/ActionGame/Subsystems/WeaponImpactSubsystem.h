@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/NetSerialization.h"
+#include "WeaponImpactSubsystem.generated.h"
+
+class AWeaponItemActor;
+class UAG_PhysicalMaterial;
+class UPhysicalMaterial;
+
+// One shot's impact as sent to clients, a few bytes instead of a full hit result.
+USTRUCT()
+struct FWeaponImpact
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY()
+	FVector_NetQuantize Location = FVector::ZeroVector;
+
+	// Octahedral encoded impact normal, 8 bits per axis.
+	UPROPERTY()
+	uint16 PackedNormal = 0;
+
+	// Index of the hit's material in UWeaponImpactSubsystem's registry, NoMaterialIndex when it isn't listed there.
+	UPROPERTY()
+	uint8 MaterialIndex = NoMaterialIndex;
+
+	static constexpr uint8 NoMaterialIndex = MAX_uint8;
+
+	void SetNormal(const FVector& InNormal);
+
+	FVector GetNormal() const;
+};
+
+struct FPendingWeaponImpacts
+{
+	TWeakObjectPtr<AWeaponItemActor> Weapon;
+
+	TArray<FWeaponImpact> Impacts;
+};
+
+/**
+ * Replicates weapon impact effects. The server batches every impact of a frame per weapon and sends each remote
+ * connection only the impacts close enough to its view, clients resolve the material index back to its impact material
+ * and play the effects through pooled Niagara components. Impact materials are listed in DefaultGame.ini, the same
+ * order on every machine gives each one a stable index.
+ */
+UCLASS(Config = Game)
+class ACTIONGAME_API UWeaponImpactSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// Server only, queues the impact to be sent to clients at the end of the frame.
+	void QueueImpact(AWeaponItemActor* InWeapon, const FHitResult& InHitResult);
+
+	void PlayReplicatedImpacts(AWeaponItemActor* InWeapon, const TArray<FWeaponImpact>& InImpacts);
+
+	void PlayImpactEffects(AWeaponItemActor* InWeapon, const FVector& InLocation, const FVector& InNormal, const UAG_PhysicalMaterial* InPhysicalMaterial);
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	void FlushImpacts();
+
+	const UAG_PhysicalMaterial* FindImpactMaterial(uint8 InMaterialIndex) const;
+
+	uint8 FindImpactMaterialIndex(const UPhysicalMaterial* InPhysicalMaterial) const;
+
+	void LoadImpactMaterials();
+
+	TArray<FPendingWeaponImpacts> PendingImpacts;
+
+	// Materials impacts can replicate, sent as their index in this list.
+	UPROPERTY(Config)
+	TArray<TSoftObjectPtr<UAG_PhysicalMaterial>> ImpactMaterialRegistry;
+
+	// The registry loaded, same indices.
+	UPROPERTY()
+	TArray<UAG_PhysicalMaterial*> ImpactMaterials;
+
+	TMap<const UPhysicalMaterial*, uint8> ImpactMaterialIndices;
+};
\ No newline at end of file
@@ -5,11 +5,73 @@
 
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
 #include "DrawDebugHelpers.h"
+#include "TimerManager.h"
+#include "ActionGameQueries.h"
 
 AAbilitySystemPhysicsVolume::AAbilitySystemPhysicsVolume()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+}
+
+void AAbilitySystemPhysicsVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (HasAuthority())
+	{
+		BuildEffectSpecs(OngoingEffectsToApply, OngoingEffectSpecs);
+		BuildEffectSpecs(OnExitEffectsToApply, OnExitEffectSpecs);
+	}
+
+	UpdateTickEnabled();
+}
+
+void AAbilitySystemPhysicsVolume::UpdateTickEnabled()
+{
+	SetActorTickEnabled(bDrawDebug || ActionGameQueries::ShouldDrawDebug(CVarShowAbilityVolumes));
+}
+
+void AAbilitySystemPhysicsVolume::BuildEffectSpecs(const TArray<TSubclassOf<UGameplayEffect>>& InEffects, TArray<FGameplayEffectSpec>& OutSpecs) const
+{
+	OutSpecs.Reset(InEffects.Num());
+
+	for (auto GameplayEffect : InEffects)
+	{
+		if (GameplayEffect)
+		{
+			FGameplayEffectContextHandle EffectContext(UAbilitySystemGlobals::Get().AllocGameplayEffectContext());
+
+			OutSpecs.Emplace(GetDefault<UGameplayEffect>(GameplayEffect), EffectContext, 1.f);
+		}
+	}
+}
+
+void AAbilitySystemPhysicsVolume::ApplyEffectSpecs(UAbilitySystemComponent* InAbilitySystemComponent, AActor* InActor, const TArray<FGameplayEffectSpec>& InSpecs, TArray<FActiveGameplayEffectHandle>* OutAppliedEffects) const
+{
+	if (InSpecs.Num() == 0)
+	{
+		return;
+	}
+
+	FGameplayEffectContextHandle EffectContext = InAbilitySystemComponent->MakeEffectContext();
+	EffectContext.AddInstigator(InActor, InActor);
+
+	for (const FGameplayEffectSpec& TemplateSpec : InSpecs)
+	{
+		// SetContext recaptures the source data from the actor, like a freshly made outgoing spec.
+		FGameplayEffectSpec Spec(TemplateSpec);
+		Spec.SetContext(EffectContext);
+
+		FActiveGameplayEffectHandle ActiveGEHandle = InAbilitySystemComponent->ApplyGameplayEffectSpecToSelf(Spec);
+
+		if (OutAppliedEffects && ActiveGEHandle.WasSuccessfullyApplied())
+		{
+			OutAppliedEffects->Add(ActiveGEHandle);
+		}
+	}
 }
 
 void AAbilitySystemPhysicsVolume::ActorEnteredVolume(class AActor* Other)
@@ -18,39 +80,93 @@ void AAbilitySystemPhysicsVolume::ActorEnteredVolume(class AActor* Other)
 
 	if (!HasAuthority()) return;
 
-	if (UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Other))
+	// Left and came back before the leave was processed, nothing changed.
+	if (PendingLeavingActors.Remove(Other) == 0)
 	{
-		for (auto Ability : PermanentAbilitiesToGive)
-		{
-			AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(Ability));
-		}
+		PendingEnteredActors.AddUnique(Other);
+	}
 
-		EnteredActorsInfoMap.Add(Other);
+	SchedulePendingActors();
+}
 
-		for (auto Ability : OngoingAbilitiesToGive)
+void AAbilitySystemPhysicsVolume::ActorLeavingVolume(class AActor* Other)
+{
+	Super::ActorLeavingVolume(Other);
+
+	if (!HasAuthority()) return;
+
+	// Entered and left again before the enter was processed, nothing to undo.
+	if (PendingEnteredActors.Remove(Other) == 0)
+	{
+		PendingLeavingActors.AddUnique(Other);
+	}
+
+	SchedulePendingActors();
+}
+
+void AAbilitySystemPhysicsVolume::SchedulePendingActors()
+{
+	if (!bProcessPendingActorsScheduled && (PendingEnteredActors.Num() > 0 || PendingLeavingActors.Num() > 0))
+	{
+		bProcessPendingActorsScheduled = true;
+
+		GetWorldTimerManager().SetTimerForNextTick(this, &AAbilitySystemPhysicsVolume::ProcessPendingActors);
+	}
+}
+
+void AAbilitySystemPhysicsVolume::ProcessPendingActors()
+{
+	bProcessPendingActorsScheduled = false;
+
+	for (const TWeakObjectPtr<AActor>& LeavingActor : PendingLeavingActors)
+	{
+		if (AActor* Other = LeavingActor.Get())
 		{
-			FGameplayAbilitySpecHandle AbilityHandle = AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(Ability));
+			HandleActorLeft(Other);
+		}
+	}
 
-			EnteredActorsInfoMap[Other].AppliedAbilities.Add(AbilityHandle);
+	for (const TWeakObjectPtr<AActor>& EnteredActor : PendingEnteredActors)
+	{
+		if (AActor* Other = EnteredActor.Get())
+		{
+			HandleActorEntered(Other);
 		}
+	}
+
+	PendingLeavingActors.Reset();
+	PendingEnteredActors.Reset();
+}
 
-		for (auto GameplayEffect : OngoingEffectsToApply)
+void AAbilitySystemPhysicsVolume::HandleActorEntered(AActor* Other)
+{
+	if (UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Other))
+	{
+		for (auto Ability : PermanentAbilitiesToGive)
 		{
-			FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
+			if (!AbilitySystemComponent->FindAbilitySpecFromClass(Ability))
+			{
+				AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(Ability));
+			}
+		}
 
-			EffectContext.AddInstigator(Other, Other);
+		FAbilityVolumeEnteredActorInfo& EnteredActorInfo = EnteredActorsInfoMap.Add(Other);
 
-			FGameplayEffectSpecHandle SpecHandle = AbilitySystemComponent->MakeOutgoingSpec(GameplayEffect, 1, EffectContext);
-			if (SpecHandle.IsValid())
+		for (auto Ability : OngoingAbilitiesToGive)
+		{
+			// Already granted, e.g. by another overlapping volume which stays responsible for removing it.
+			if (AbilitySystemComponent->FindAbilitySpecFromClass(Ability))
 			{
-				FActiveGameplayEffectHandle ActiveGEHandle = AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
-				if (ActiveGEHandle.WasSuccessfullyApplied())
-				{
-					EnteredActorsInfoMap[Other].AppliedEffects.Add(ActiveGEHandle);
-				}
+				continue;
 			}
+
+			FGameplayAbilitySpecHandle AbilityHandle = AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(Ability));
+
+			EnteredActorInfo.AppliedAbilities.Add(AbilityHandle);
 		}
 
+		ApplyEffectSpecs(AbilitySystemComponent, Other, OngoingEffectSpecs, &EnteredActorInfo.AppliedEffects);
+
 		for (auto EventTag : GameplayEventsToSendOnEnter)
 		{
 			FGameplayEventData EventPayload;
@@ -61,41 +177,32 @@ void AAbilitySystemPhysicsVolume::ActorEnteredVolume(class AActor* Other)
 	}
 }
 
-void AAbilitySystemPhysicsVolume::ActorLeavingVolume(class AActor* Other)
+void AAbilitySystemPhysicsVolume::HandleActorLeft(AActor* Other)
 {
-	Super::ActorLeavingVolume(Other);
-
-	if (!HasAuthority()) return;
-
 	if (UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Other))
 	{
-		if (EnteredActorsInfoMap.Find(Other))
+		if (FAbilityVolumeEnteredActorInfo* EnteredActorInfo = EnteredActorsInfoMap.Find(Other))
 		{
-			for (auto GameplayEffectHandle : EnteredActorsInfoMap[Other].AppliedEffects)
+			for (auto GameplayEffectHandle : EnteredActorInfo->AppliedEffects)
 			{
 				AbilitySystemComponent->RemoveActiveGameplayEffect(GameplayEffectHandle);
 			}
 
-			for (auto GameplayAbilityHandle : EnteredActorsInfoMap[Other].AppliedAbilities)
+			for (auto GameplayAbilityHandle : EnteredActorInfo->AppliedAbilities)
 			{
-				AbilitySystemComponent->ClearAbility(GameplayAbilityHandle);
+				const FGameplayAbilitySpec* AbilitySpec = AbilitySystemComponent->FindAbilitySpecFromHandle(GameplayAbilityHandle);
+				TSubclassOf<UGameplayAbility> AbilityClass = AbilitySpec && AbilitySpec->Ability ? AbilitySpec->Ability->GetClass() : nullptr;
+
+				if (!AdoptAbility(Other, AbilityClass, GameplayAbilityHandle))
+				{
+					AbilitySystemComponent->ClearAbility(GameplayAbilityHandle);
+				}
 			}
 
 			EnteredActorsInfoMap.Remove(Other);
 		}
 
-		for (auto GameplayEffect : OnExitEffectsToApply)
-		{
-			FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
-
-			EffectContext.AddInstigator(Other, Other);
-
-			FGameplayEffectSpecHandle SpecHandle = AbilitySystemComponent->MakeOutgoingSpec(GameplayEffect, 1, EffectContext);
-			if (SpecHandle.IsValid())
-			{
-				FActiveGameplayEffectHandle ActiveGEHandle = AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
-			}
-		}
+		ApplyEffectSpecs(AbilitySystemComponent, Other, OnExitEffectSpecs, nullptr);
 
 		for (auto EventTag : GameplayEventsToSendOnExit)
 		{
@@ -107,11 +214,41 @@ void AAbilitySystemPhysicsVolume::ActorLeavingVolume(class AActor* Other)
 	}
 }
 
+bool AAbilitySystemPhysicsVolume::AdoptAbility(AActor* InActor, TSubclassOf<UGameplayAbility> InAbilityClass, FGameplayAbilitySpecHandle InAbilityHandle)
+{
+	if (!InAbilityClass)
+	{
+		return false;
+	}
+
+	TArray<AActor*> OverlappingVolumes;
+	InActor->GetOverlappingActors(OverlappingVolumes, AAbilitySystemPhysicsVolume::StaticClass());
+
+	for (AActor* OverlappingActor : OverlappingVolumes)
+	{
+		AAbilitySystemPhysicsVolume* OtherVolume = Cast<AAbilitySystemPhysicsVolume>(OverlappingActor);
+
+		if (OtherVolume == this || !OtherVolume->OngoingAbilitiesToGive.Contains(InAbilityClass))
+		{
+			continue;
+		}
+
+		if (FAbilityVolumeEnteredActorInfo* OtherEnteredActorInfo = OtherVolume->EnteredActorsInfoMap.Find(InActor))
+		{
+			OtherEnteredActorInfo->AppliedAbilities.Add(InAbilityHandle);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void AAbilitySystemPhysicsVolume::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
-	if (bDrawDebug)
+	if (bDrawDebug || ActionGameQueries::ShouldDrawDebug(CVarShowAbilityVolumes))
 	{
 		DrawDebugBox(GetWorld(), GetActorLocation(), GetBounds().BoxExtent, FColor::Red, false, 0, 0, 5);
 	}
@@ -5,11 +5,13 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PhysicsVolume.h"
 #include "GameplayAbilitySpec.h"
+#include "GameplayEffect.h"
 #include "GameplayTagContainer.h"
 #include "AbilitySystemPhysicsVolume.generated.h"
 
 class UGameplayEffect;
 class UGameplayAbility;
+class UAbilitySystemComponent;
 
 USTRUCT(BlueprintType)
 struct FAbilityVolumeEnteredActorInfo
@@ -51,6 +53,35 @@ protected:
 
 	TMap<AActor*, FAbilityVolumeEnteredActorInfo> EnteredActorsInfoMap;
 
+	// Built once in BeginPlay, copied and given the entering actor's context when applied.
+	TArray<FGameplayEffectSpec> OngoingEffectSpecs;
+
+	TArray<FGameplayEffectSpec> OnExitEffectSpecs;
+
+	// Actors that crossed the volume since the last processing. Crossing back within the same frame cancels out.
+	TArray<TWeakObjectPtr<AActor>> PendingEnteredActors;
+
+	TArray<TWeakObjectPtr<AActor>> PendingLeavingActors;
+
+	bool bProcessPendingActorsScheduled = false;
+
+	virtual void BeginPlay() override;
+
+	void BuildEffectSpecs(const TArray<TSubclassOf<UGameplayEffect>>& InEffects, TArray<FGameplayEffectSpec>& OutSpecs) const;
+
+	void ApplyEffectSpecs(UAbilitySystemComponent* InAbilitySystemComponent, AActor* InActor, const TArray<FGameplayEffectSpec>& InSpecs, TArray<FActiveGameplayEffectHandle>* OutAppliedEffects) const;
+
+	void SchedulePendingActors();
+
+	void ProcessPendingActors();
+
+	void HandleActorEntered(AActor* Other);
+
+	void HandleActorLeft(AActor* Other);
+
+	// Another overlapping volume granting the same ability keeps it alive after this one is left.
+	bool AdoptAbility(AActor* InActor, TSubclassOf<UGameplayAbility> InAbilityClass, FGameplayAbilitySpecHandle InAbilityHandle);
+
 public:
 
 	AAbilitySystemPhysicsVolume();
@@ -60,4 +91,6 @@ public:
 	virtual void ActorLeavingVolume(class AActor* Other) override;
 
 	virtual void Tick(float DeltaSeconds) override;
+
+	void UpdateTickEnabled();
 };